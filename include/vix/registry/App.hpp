@@ -1,11 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <chrono>
 #include <cstdint>
+#include <mutex>
 
 #include <vix/config/Config.hpp>
+#include <vix/registry/SignalWatcher.hpp>
 #include <vix/registry/http/HttpServer.hpp>
 #include <vix/registry/db/Database.hpp>
+#include <vix/registry/services/ArtifactScrubber.hpp>
+#include <vix/registry/storage/IPackageStore.hpp>
 
 namespace vix::registry
 {
@@ -17,15 +23,38 @@ namespace vix::registry
 
         int run();
 
+        // SIGTERM / SIGINT: drain, flush and stop. Safe to call repeatedly.
+        void shutdown();
+
+        // SIGHUP: re-read the config file and apply runtime-tunable settings.
+        void reload();
+
     private:
         static const char *resolveConfigPath();
         static std::shared_ptr<db::Database> initDatabase(const vix::config::Config &cfg);
+        static std::shared_ptr<storage::IPackageStore> initStorage(const vix::config::Config &cfg);
+        void applyRuntimeConfig(const vix::config::Config &cfg);
+
+        // SIGTERM / SIGINT: shutdown() once serving, immediate exit before.
+        void terminate(int signal);
 
     private:
         vix::config::Config config_;
         std::uint16_t port_{8080};
 
         std::shared_ptr<db::Database> db_;
+        std::shared_ptr<storage::IPackageStore> store_;
+        std::shared_ptr<services::ArtifactScrubber> scrubber_;
         std::unique_ptr<http::HttpServer> server_;
+
+        // Written by reload() on the signal thread, read by shutdown().
+        std::atomic<std::chrono::milliseconds> drainTimeout_{std::chrono::milliseconds(30000)};
+        std::once_flag shutdownOnce_;
+
+        // Set by run() once startup is done; signals before that exit.
+        std::atomic<bool> serving_{false};
+
+        // Declared last: stopped first, before anything its handlers touch.
+        SignalWatcher signals_;
     };
 }
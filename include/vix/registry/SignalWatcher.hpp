@@ -0,0 +1,38 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <thread>
+
+namespace vix::registry
+{
+    /**
+     * Delivers process signals to ordinary callbacks on a dedicated thread.
+     *
+     * blockSignals() must run before any other thread is spawned so every
+     * thread inherits the mask; the watcher then picks the signals up with
+     * sigwait(), which means callbacks may lock, allocate and join freely.
+     */
+    class SignalWatcher
+    {
+    public:
+        using Handler = std::function<void(int)>;
+
+        SignalWatcher() = default;
+        ~SignalWatcher();
+
+        SignalWatcher(const SignalWatcher &) = delete;
+        SignalWatcher &operator=(const SignalWatcher &) = delete;
+
+        // Blocks SIGTERM, SIGINT and SIGHUP in the calling thread.
+        static void blockSignals();
+
+        void on(int signal, Handler handler);
+        void start();
+        void stop();
+
+    private:
+        std::map<int, Handler> handlers_;
+        std::thread thread_;
+    };
+} // namespace vix::registry
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vix::registry::db
+{
+    // What `versions` says a blob should be.
+    struct ArtifactRecord
+    {
+        std::string sha256;
+        std::uint64_t sizeBytes{0};
+    };
+
+    /**
+     * Maps storage keys back to `versions` rows. Keys absent from the
+     * returned map are referenced by no version.
+     */
+    class IArtifactIndex
+    {
+    public:
+        virtual ~IArtifactIndex() = default;
+        virtual std::unordered_map<std::string, ArtifactRecord>
+        lookup(const std::vector<std::string> &artifactPaths) = 0;
+    };
+} // namespace vix::registry::db
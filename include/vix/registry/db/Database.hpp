@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
 #include <vix/orm/ConnectionPool.hpp>
@@ -36,6 +37,10 @@ namespace vix::registry::db
         explicit Database(const DatabaseConfig &config);
         Pool &pool() noexcept { return pool_; }
         const Pool &pool() const noexcept { return pool_; }
+
+        // Pool bounds are fixed for the life of the process: the ORM pool
+        // cannot shrink or close idle connections, so POOL_MIN / POOL_MAX
+        // changes take a restart.
         DatabaseConfig config() const { return config_; }
         UnitOfWork makeUnitOfWork();
         Transaction makeTransaction();
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vix/registry/domain/Version.hpp>
+
+namespace vix::registry::db
+{
+    enum class PublishStatus
+    {
+        Committed,
+        Conflict, // (package_id, semver) already exists
+        Failed
+    };
+
+    struct PublishResult
+    {
+        PublishStatus status{PublishStatus::Failed};
+        std::uint64_t versionId{0};
+        std::string message;
+    };
+
+    /**
+     * Persists a batch of versions in as few transactions as possible.
+     * Must return exactly one result per input row, in input order.
+     */
+    class IVersionBatchWriter
+    {
+    public:
+        virtual ~IVersionBatchWriter() = default;
+        virtual std::vector<PublishResult> writeBatch(const std::vector<domain::Version> &batch) = 0;
+    };
+
+    struct PublishQueueConfig
+    {
+        std::size_t maxBatch = 256;
+        std::size_t maxPending = 4096;
+
+        // How long the committer lingers after the first record of a batch
+        // to let concurrent publishes join it.
+        std::chrono::microseconds maxDelay{2000};
+    };
+
+    /**
+     * Group-commit stage for publishes.
+     *
+     * Callers enqueue already validated versions and get a future; a single
+     * committer thread drains the queue in batches through the writer, so a
+     * burst of N publishes costs one transaction (and one fsync) per batch
+     * instead of N.
+     */
+    class PublishQueue
+    {
+    public:
+        explicit PublishQueue(std::shared_ptr<IVersionBatchWriter> writer,
+                              PublishQueueConfig config = {});
+        ~PublishQueue();
+
+        PublishQueue(const PublishQueue &) = delete;
+        PublishQueue &operator=(const PublishQueue &) = delete;
+
+        // Blocks while `maxPending` records are already waiting.
+        std::future<PublishResult> enqueue(domain::Version version);
+
+        // Applies new batching limits to subsequent batches.
+        void reconfigure(PublishQueueConfig config);
+
+        // Commits everything enqueued so far, then stops the committer.
+        // Later enqueue() calls complete immediately with Failed.
+        void stop();
+
+        std::size_t pending() const;
+        std::uint64_t batchesCommitted() const;
+
+    private:
+        struct Item
+        {
+            domain::Version version;
+            std::promise<PublishResult> promise;
+        };
+
+        void committerLoop();
+        void commit(std::vector<Item> &batch);
+
+        std::shared_ptr<IVersionBatchWriter> writer_;
+        PublishQueueConfig config_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable hasWork_;
+        std::condition_variable hasRoom_;
+        std::deque<Item> queue_;
+        bool stopping_{false};
+        std::uint64_t batches_{0};
+
+        std::mutex joinMutex_;
+        std::thread committer_;
+    };
+} // namespace vix::registry::db
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <vix/registry/db/ArtifactIndex.hpp>
+#include <vix/registry/db/Database.hpp>
+#include <vix/registry/db/VersionLookup.hpp>
+
+namespace vix::registry::db
+{
+    /**
+     * MySQL index over `versions.artifact_path` (idx_versions_artifact_path,
+     * migration 0003) and over `versions` by package name and semver.
+     * Lookups are chunked IN (...) queries on a pooled connection, no
+     * transaction.
+     */
+    class VersionArtifactIndex : public IArtifactIndex, public IVersionLookup
+    {
+    public:
+        explicit VersionArtifactIndex(std::shared_ptr<Database> db);
+
+        std::unordered_map<std::string, ArtifactRecord>
+        lookup(const std::vector<std::string> &artifactPaths) override;
+
+        std::vector<VersionArtifact>
+        findArtifacts(const std::string &packageName, const std::string &semver) override;
+
+    private:
+        std::shared_ptr<Database> db_;
+    };
+} // namespace vix::registry::db
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <vix/registry/db/Database.hpp>
+#include <vix/registry/db/PublishQueue.hpp>
+
+namespace vix::registry::db
+{
+    /**
+     * MySQL writer for PublishQueue.
+     *
+     * One transaction per batch: read existing (package_id, semver) rows
+     * without locking them, report them as conflicts, then insert the rest
+     * with multi-row INSERTs. A deadlock or lock wait timeout reruns the
+     * batch a few times. Any other failure, such as a unique-key race with
+     * another pod or a row the server rejects, rolls the batch back and
+     * replays it row by row so each caller gets its own outcome.
+     */
+    class VersionBatchWriter : public IVersionBatchWriter
+    {
+    public:
+        explicit VersionBatchWriter(std::shared_ptr<Database> db);
+
+        std::vector<PublishResult> writeBatch(const std::vector<domain::Version> &batch) override;
+
+    private:
+        std::vector<PublishResult> writeGrouped(const std::vector<domain::Version> &batch);
+        PublishResult writeOne(const domain::Version &version);
+
+        std::shared_ptr<Database> db_;
+    };
+} // namespace vix::registry::db
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vix::registry::db
+{
+    // The `versions` columns a download needs.
+    struct VersionArtifact
+    {
+        std::string artifactPath;
+        std::string sha256;
+        std::uint64_t sizeBytes{0};
+        bool yanked{false};
+    };
+
+    /**
+     * Finds the versions published as `packageName@semver` in public
+     * packages. Package names are only unique per owner, so several rows
+     * may come back.
+     */
+    class IVersionLookup
+    {
+    public:
+        virtual ~IVersionLookup() = default;
+        virtual std::vector<VersionArtifact>
+        findArtifacts(const std::string &packageName, const std::string &semver) = 0;
+    };
+} // namespace vix::registry::db
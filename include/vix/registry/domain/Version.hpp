@@ -3,10 +3,15 @@
 #include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace vix::registry::domain
 {
+    // SemVer 2.0.0: MAJOR.MINOR.PATCH[-prerelease][+build], no leading
+    // zeros in numeric identifiers.
+    bool isValidSemver(std::string_view semver) noexcept;
+
     class Version
     {
     public:
@@ -23,6 +23,19 @@ namespace vix::registry::domain
         explicit NotFoundError(const std::string &msg) : RegistryError(msg) {}
     };
 
+    class ConflictError : public RegistryError
+    {
+    public:
+        explicit ConflictError(const std::string &msg) : RegistryError(msg) {}
+    };
+
+    // The resource exists but was withdrawn (e.g. a yanked version).
+    class GoneError : public RegistryError
+    {
+    public:
+        explicit GoneError(const std::string &msg) : RegistryError(msg) {}
+    };
+
     class AuthError : public RegistryError
     {
     public:
@@ -34,4 +47,10 @@ namespace vix::registry::domain
     public:
         explicit DbError(const std::string &msg) : RegistryError(msg) {}
     };
+
+    class StorageError : public RegistryError
+    {
+    public:
+        explicit StorageError(const std::string &msg) : RegistryError(msg) {}
+    };
 } // namespace vix::registry::domain
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include <vix/registry/storage/IPackageStore.hpp>
+
+namespace vix::registry::http
+{
+    inline constexpr std::uint64_t kArtifactChunk = 1024 * 1024;
+
+    /**
+     * Copies the first `size` bytes of `key` to `write`, one bounded chunk
+     * at a time, so a download holds at most `chunk` bytes in memory
+     * whatever the artifact size.
+     *
+     * Throws domain::NotFoundError if the blob disappears and
+     * domain::StorageError if it ends before `size`.
+     */
+    void streamArtifact(storage::IPackageStore &store,
+                        const std::string &key,
+                        std::uint64_t size,
+                        const std::function<void(std::string_view)> &write,
+                        std::uint64_t chunk = kArtifactChunk);
+} // namespace vix::registry::http
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <vix.hpp>
 #include <vix/registry/db/Database.hpp>
+#include <vix/registry/http/Lifecycle.hpp>
+#include <vix/registry/services/ArtifactScrubber.hpp>
+#include <vix/registry/services/DownloadService.hpp>
+#include <vix/registry/storage/IPackageStore.hpp>
 
 namespace vix::registry::http
 {
@@ -11,19 +16,41 @@ namespace vix::registry::http
     {
     public:
         HttpServer(std::uint16_t port,
-                   std::shared_ptr<vix::registry::db::Database> db);
+                   std::shared_ptr<vix::registry::db::Database> db,
+                   std::shared_ptr<vix::registry::storage::IPackageStore> store = nullptr,
+                   std::shared_ptr<vix::registry::services::DownloadService> downloads = nullptr,
+                   std::chrono::seconds downloadTtl = std::chrono::seconds(300));
 
         void run();
         vix::App &app() { return app_; }
 
+        // Graceful shutdown: refuse new requests (503, health goes red),
+        // wait for in-flight ones until `deadline`, then stop the listener.
+        void beginDrain();
+        bool waitDrained(std::chrono::steady_clock::time_point deadline);
+        void stop();
+
+        InflightTracker &inflight() noexcept { return inflight_; }
+
+        // Exposes scrubber progress on /metrics/scrub. Call before run().
+        void setScrubber(std::shared_ptr<vix::registry::services::ArtifactScrubber> scrubber);
+
     private:
         void setupRoutes();
         void initRoutes();
 
+        template <typename Handler>
+        auto admitted(Handler handler);
+
         std::uint16_t port_{8080};
         vix::App app_;
 
         std::shared_ptr<vix::registry::db::Database> db_;
+        std::shared_ptr<vix::registry::storage::IPackageStore> store_;
+        std::shared_ptr<vix::registry::services::DownloadService> downloads_;
+        std::chrono::seconds downloadTtl_{300};
+        std::shared_ptr<vix::registry::services::ArtifactScrubber> scrubber_;
+        InflightTracker inflight_;
         bool routesInitialized_{false};
     };
 }
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace vix::registry::http
+{
+    /**
+     * Counts in-flight requests and gates new ones during shutdown.
+     *
+     * Handlers hold a Guard until they return. Artifact bodies are
+     * streamed from inside the handler, so a slow download keeps its Guard
+     * until the last chunk is written; small JSON replies are flushed by
+     * the server just after. Once draining starts tryEnter() refuses new
+     * work, and waitIdle() lets the shutdown path wait for the rest to
+     * finish.
+     */
+    class InflightTracker
+    {
+    public:
+        class Guard
+        {
+        public:
+            explicit Guard(InflightTracker *tracker) noexcept : tracker_(tracker) {}
+            Guard(Guard &&other) noexcept : tracker_(other.tracker_) { other.tracker_ = nullptr; }
+            Guard &operator=(Guard &&) = delete;
+            Guard(const Guard &) = delete;
+            Guard &operator=(const Guard &) = delete;
+
+            ~Guard()
+            {
+                if (tracker_)
+                    tracker_->leave();
+            }
+
+        private:
+            InflightTracker *tracker_;
+        };
+
+        std::optional<Guard> tryEnter();
+
+        void beginDrain();
+        bool draining() const noexcept { return draining_.load(std::memory_order_acquire); }
+        std::size_t inflight() const noexcept { return inflight_.load(std::memory_order_acquire); }
+
+        // True if every in-flight request finished before `deadline`.
+        bool waitIdle(std::chrono::steady_clock::time_point deadline);
+
+    private:
+        void leave();
+
+        std::atomic<bool> draining_{false};
+        std::atomic<std::size_t> inflight_{0};
+
+        std::mutex mutex_;
+        std::condition_variable idle_;
+    };
+} // namespace vix::registry::http
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include <vix/registry/trace/Tracing.hpp>
+
+namespace vix::registry::http
+{
+    /**
+     * Wraps a route handler with request tracing.
+     *
+     * Propagates a safe incoming `X-Request-Id` (or generates one), makes a
+     * RequestTrace current for the handler so lower layers can record
+     * spans, then sets `X-Request-Id` / `Server-Timing` on the response and
+     * emits the sampled JSON log line.
+     */
+    template <typename Handler>
+    auto traced(Handler handler)
+    {
+        return [handler = std::move(handler)](auto &req, auto &res)
+        {
+            const trace::TraceConfig cfg = trace::traceConfig();
+            if (!cfg.enabled)
+            {
+                handler(req, res);
+                return;
+            }
+
+            trace::RequestTrace requestTrace(std::string(req.method()),
+                                             std::string(req.path()),
+                                             trace::sanitizeRequestId(req.header("X-Request-Id")));
+            try
+            {
+                handler(req, res);
+            }
+            catch (...)
+            {
+                requestTrace.setStatus(500);
+                trace::emitTraceLog(requestTrace);
+                throw;
+            }
+
+            res.header("X-Request-Id", requestTrace.requestId());
+            if (cfg.serverTiming)
+                res.header("Server-Timing", requestTrace.serverTiming());
+            trace::emitTraceLog(requestTrace);
+        };
+    }
+
+    // Notes the status a handler answered with on the current trace.
+    inline void traceStatus(int status) noexcept
+    {
+        if (auto *current = trace::RequestTrace::current())
+            current->setStatus(status);
+    }
+
+    // Sets the response status and records it on the current trace. Use it
+    // instead of `res.status(n)` so the access log agrees with the client:
+    //   withStatus(res, 404).json(...);
+    template <typename Response>
+    decltype(auto) withStatus(Response &res, int status)
+    {
+        traceStatus(status);
+        return res.status(status);
+    }
+} // namespace vix::registry::http
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vix/registry/db/ArtifactIndex.hpp>
+#include <vix/registry/storage/IPackageStore.hpp>
+
+namespace vix::registry::services
+{
+    /**
+     * Byte-rate budget shared by several threads. Allows a burst of up to
+     * one second worth of bytes after an idle period.
+     */
+    class ByteRateLimiter
+    {
+    public:
+        explicit ByteRateLimiter(std::uint64_t bytesPerSecond); // 0: unlimited
+
+        // Blocks until `bytes` fit the budget. Returns false if `cancelled`
+        // became true while waiting.
+        bool acquire(std::uint64_t bytes, const std::atomic<bool> &cancelled);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::uint64_t bytesPerSecond_;
+        std::mutex mutex_;
+        Clock::time_point next_{};
+    };
+
+    struct ScrubConfig
+    {
+        std::size_t pageSize = 500;
+        std::size_t hashWorkers = 0; // 0: one per core
+
+        // Read budget for checksum verification, across all workers.
+        std::uint64_t maxBytesPerSecond = 64ull * 1024 * 1024;
+
+        // Unreferenced blobs younger than this may belong to a publish whose
+        // version row is not committed yet.
+        std::chrono::seconds orphanGrace{24 * 3600};
+        std::chrono::seconds uploadGrace{24 * 3600};
+
+        // Off: orphans are only counted.
+        bool deleteOrphans = false;
+
+        // A page where a larger share of the objects are orphans is not
+        // collected: an index pointing at the wrong database or a truncated
+        // table would otherwise empty the store. 100 disables the check.
+        std::size_t maxOrphanPercent = 50;
+
+        // Pause between background passes.
+        std::chrono::seconds interval{6 * 3600};
+
+        // Where the walk cursor is saved after each page so an interrupted
+        // pass resumes after a restart. Empty: keep it in memory only.
+        std::filesystem::path checkpointPath;
+    };
+
+    struct ScrubStats
+    {
+        bool running = false;
+        std::string cursor; // last key of the last finished page
+
+        std::uint64_t passesCompleted = 0;
+        std::uint64_t objectsScanned = 0;
+        std::uint64_t bytesVerified = 0;
+        std::uint64_t verified = 0;
+        std::uint64_t corrupt = 0;
+        std::uint64_t quarantined = 0;
+        std::uint64_t orphansFound = 0;
+        std::uint64_t orphansDeleted = 0;
+        std::uint64_t orphanBytesFreed = 0;
+        std::uint64_t orphanDeletesSkipped = 0; // held back by maxOrphanPercent
+        std::uint64_t staleUploadsPurged = 0;
+        std::uint64_t errors = 0;
+
+        std::chrono::milliseconds lastPassDuration{0};
+        std::string lastError;
+    };
+
+    /**
+     * Reconciles the blob store with `versions`.
+     *
+     * Walks the store one page at a time (resumable cursor), re-hashes
+     * referenced blobs on `hashWorkers` threads under a shared byte budget,
+     * quarantines blobs whose size or sha256 disagree with their row, and
+     * reports blobs no row references once they are older than the grace
+     * period, deleting them only when enabled. Counters are cumulative
+     * since construction.
+     */
+    class ArtifactScrubber
+    {
+    public:
+        ArtifactScrubber(std::shared_ptr<storage::IPackageStore> store,
+                         std::shared_ptr<db::IArtifactIndex> index,
+                         ScrubConfig config = {});
+        ~ArtifactScrubber();
+
+        ArtifactScrubber(const ArtifactScrubber &) = delete;
+        ArtifactScrubber &operator=(const ArtifactScrubber &) = delete;
+
+        // Runs passes every `interval` on a background thread.
+        void start();
+
+        // Interrupts the current pass (its cursor is kept) and joins.
+        void stop();
+
+        // One pass from the saved cursor to the end of the store. Returns
+        // false if it stopped early (stop() or a listing failure); the next
+        // pass resumes from the cursor.
+        bool runPass();
+
+        // Applies to the next pass.
+        void reconfigure(ScrubConfig config);
+
+        ScrubStats stats() const;
+
+    private:
+        struct Counters
+        {
+            std::atomic<std::uint64_t> objectsScanned{0};
+            std::atomic<std::uint64_t> bytesVerified{0};
+            std::atomic<std::uint64_t> verified{0};
+            std::atomic<std::uint64_t> corrupt{0};
+            std::atomic<std::uint64_t> quarantined{0};
+            std::atomic<std::uint64_t> orphansFound{0};
+            std::atomic<std::uint64_t> orphansDeleted{0};
+            std::atomic<std::uint64_t> orphanBytesFreed{0};
+            std::atomic<std::uint64_t> orphanDeletesSkipped{0};
+            std::atomic<std::uint64_t> staleUploadsPurged{0};
+            std::atomic<std::uint64_t> errors{0};
+        };
+
+        enum class Verdict
+        {
+            Intact,
+            Corrupt,
+            Skipped // vanished or interrupted
+        };
+
+        void backgroundLoop();
+        void scrubPage(const std::vector<storage::ObjectInfo> &objects,
+                       const ScrubConfig &config,
+                       ByteRateLimiter &limiter);
+        Verdict verify(const storage::ObjectInfo &object,
+                       const db::ArtifactRecord &record,
+                       ByteRateLimiter &limiter);
+        void deleteOrphans(const std::vector<storage::ObjectInfo> &candidates);
+
+        void loadCursor(const ScrubConfig &config);
+        void saveCursor(const ScrubConfig &config, const std::string &cursor);
+        void recordError(const std::string &message);
+
+        std::shared_ptr<storage::IPackageStore> store_;
+        std::shared_ptr<db::IArtifactIndex> index_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable wake_;
+        ScrubConfig config_;
+        std::string cursor_;
+        bool running_{false};
+        bool cursorLoaded_{false};
+        std::uint64_t passesCompleted_{0};
+        std::chrono::milliseconds lastPassDuration_{0};
+        std::string lastError_;
+
+        Counters counters_;
+        std::atomic<bool> stopping_{false};
+
+        std::mutex passMutex_;
+        std::mutex joinMutex_;
+        std::thread worker_;
+    };
+} // namespace vix::registry::services
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <vix/registry/db/VersionLookup.hpp>
+
+namespace vix::registry::services
+{
+    struct ResolvedArtifact
+    {
+        std::string key; // storage key, from versions.artifact_path
+        std::string sha256;
+        std::uint64_t sizeBytes{0};
+    };
+
+    /**
+     * Maps `/v1/artifacts/{name}/{version}/{file}` to the blob recorded in
+     * `versions`. `file` must be the last segment of the version's
+     * artifact_path.
+     */
+    class DownloadService
+    {
+    public:
+        explicit DownloadService(std::shared_ptr<db::IVersionLookup> versions);
+
+        // Throws domain::NotFoundError (unknown version or file),
+        // domain::GoneError (yanked) and domain::ConflictError (the name is
+        // published by several owners).
+        ResolvedArtifact resolve(const std::string &name,
+                                 const std::string &version,
+                                 const std::string &file);
+
+    private:
+        std::shared_ptr<db::IVersionLookup> versions_;
+    };
+} // namespace vix::registry::services
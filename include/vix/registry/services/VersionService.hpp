@@ -0,0 +1,27 @@
+#pragma once
+
+#include <future>
+#include <memory>
+
+#include <vix/registry/db/PublishQueue.hpp>
+#include <vix/registry/domain/Version.hpp>
+
+namespace vix::registry::services
+{
+    // Publish path for the upcoming publish endpoint, which will own the
+    // PublishQueue. Nothing in App constructs it yet.
+    class VersionService
+    {
+    public:
+        explicit VersionService(std::shared_ptr<db::PublishQueue> publishQueue);
+
+        // Validates the record and hands it to the group-commit queue.
+        // Throws domain::ValidationError; conflicts come back in the result.
+        std::future<db::PublishResult> publish(domain::Version version);
+
+        static void validate(const domain::Version &version);
+
+    private:
+        std::shared_ptr<db::PublishQueue> publishQueue_;
+    };
+} // namespace vix::registry::services
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vix::registry::storage
+{
+    struct ObjectInfo
+    {
+        std::string key;
+        std::uint64_t sizeBytes{0};
+
+        // Empty when the backend does not report it; callers must not
+        // read that as "old".
+        std::optional<std::chrono::system_clock::time_point> lastModified;
+    };
+
+    struct ObjectPage
+    {
+        std::vector<ObjectInfo> objects;
+
+        // Last key of this page when more objects follow, empty otherwise.
+        std::optional<std::string> nextStartAfter;
+    };
+
+    /**
+     * Keys are relative '/'-separated paths. Empty, "." and ".." segments are
+     * rejected, as are segments starting with '.', which backends reserve for
+     * their own bookkeeping (temp uploads, quarantine).
+     */
+    inline bool isValidKey(std::string_view key)
+    {
+        if (key.empty() || key.size() > 512)
+            return false;
+
+        std::size_t start = 0;
+        while (start <= key.size())
+        {
+            const std::size_t end = std::min(key.find('/', start), key.size());
+            const std::string_view seg = key.substr(start, end - start);
+            if (seg.empty() || seg.front() == '.')
+                return false;
+            for (char c : seg)
+            {
+                if (c == '\\' || static_cast<unsigned char>(c) < 0x20)
+                    return false;
+            }
+            start = end + 1;
+        }
+        return true;
+    }
+
+    /**
+     * Artifact blob store.
+     *
+     * Keys are relative, '/'-separated paths (the value stored in
+     * `versions.artifact_path`). Metadata lives in the DB; implementations
+     * only deal with bytes.
+     *
+     * Errors: missing keys on read raise domain::NotFoundError, invalid keys
+     * raise domain::ValidationError, backend failures raise
+     * domain::StorageError.
+     */
+    class IPackageStore
+    {
+    public:
+        virtual ~IPackageStore() = default;
+
+        virtual void put(const std::string &key, std::string_view data) = 0;
+        virtual void putFile(const std::string &key, const std::filesystem::path &source) = 0;
+
+        virtual std::string read(const std::string &key,
+                                 std::uint64_t offset,
+                                 std::uint64_t length) = 0;
+        virtual void getToFile(const std::string &key, const std::filesystem::path &target) = 0;
+
+        virtual std::optional<std::uint64_t> size(const std::string &key) = 0;
+        virtual bool exists(const std::string &key) { return size(key).has_value(); }
+        virtual void remove(const std::string &key) = 0;
+
+        // Moves `key` out of the live keyspace (under `.quarantine/`) for
+        // later inspection instead of deleting it.
+        virtual void quarantine(const std::string &key) = 0;
+
+        // Drops upload leftovers (temp files, unfinished multipart uploads)
+        // started before `olderThan`. Returns how many were removed.
+        virtual std::size_t purgeStaleUploads(std::chrono::system_clock::time_point olderThan) = 0;
+
+        // Keys under `prefix`, in lexicographic order, strictly after `startAfter`.
+        virtual ObjectPage list(const std::string &prefix,
+                                const std::string &startAfter,
+                                std::size_t limit) = 0;
+
+        // URL clients can fetch directly (e.g. a presigned S3 URL), or nullopt
+        // when the backend can only be read through the registry.
+        virtual std::optional<std::string> downloadUrl(const std::string &key,
+                                                       std::chrono::seconds ttl) = 0;
+    };
+} // namespace vix::registry::storage
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <vix/registry/storage/IPackageStore.hpp>
+
+namespace vix::registry::storage
+{
+    /**
+     * Artifacts as plain files under a root directory (dev / single node).
+     *
+     * Writes go to `<root>/.tmp/` first and are renamed into place, so a
+     * reader never observes a partially written blob.
+     */
+    class LocalFileStorage : public IPackageStore
+    {
+    public:
+        explicit LocalFileStorage(std::filesystem::path root);
+
+        const std::filesystem::path &root() const noexcept { return root_; }
+        std::filesystem::path pathFor(const std::string &key) const;
+
+        void put(const std::string &key, std::string_view data) override;
+        void putFile(const std::string &key, const std::filesystem::path &source) override;
+
+        std::string read(const std::string &key,
+                         std::uint64_t offset,
+                         std::uint64_t length) override;
+        void getToFile(const std::string &key, const std::filesystem::path &target) override;
+
+        std::optional<std::uint64_t> size(const std::string &key) override;
+        void remove(const std::string &key) override;
+        void quarantine(const std::string &key) override;
+        std::size_t purgeStaleUploads(std::chrono::system_clock::time_point olderThan) override;
+
+        ObjectPage list(const std::string &prefix,
+                        const std::string &startAfter,
+                        std::size_t limit) override;
+
+        std::optional<std::string> downloadUrl(const std::string &key,
+                                               std::chrono::seconds ttl) override;
+
+    private:
+        struct DirEntry
+        {
+            std::string name; // with a trailing '/' for directories
+            bool isDirectory{false};
+        };
+
+        std::filesystem::path tempPath() const;
+        void commit(const std::filesystem::path &tmp, const std::string &key);
+
+        // Children of `dir` (relative, "" or ending in '/'), hidden entries
+        // excluded, in the order their keys sort.
+        std::vector<DirEntry> sortedEntries(const std::string &dir) const;
+
+        // Appends keys below `dir` in order until `keys` holds `want`.
+        // Returns false once it does.
+        bool collectKeys(const std::string &dir,
+                         const std::string &prefix,
+                         const std::string &startAfter,
+                         std::size_t want,
+                         std::vector<std::string> &keys) const;
+
+        std::filesystem::path root_;
+    };
+} // namespace vix::registry::storage
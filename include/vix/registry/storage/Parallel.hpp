@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vix::registry::storage
+{
+    // Runs fn(0..count-1) on up to `workers` threads (the caller being one
+    // of them). Stops handing out work after the first failure and rethrows
+    // it on the caller.
+    template <typename Fn>
+    void runParallel(std::size_t count, std::size_t workers, Fn fn)
+    {
+        workers = std::max<std::size_t>(1, std::min(workers, count));
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto loop = [&]
+        {
+            for (;;)
+            {
+                const std::size_t i = next.fetch_add(1);
+                if (i >= count || failed.load())
+                    return;
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                        error = std::current_exception();
+                    failed.store(true);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (std::size_t t = 1; t < workers; ++t)
+            threads.emplace_back(loop);
+        loop();
+        for (auto &t : threads)
+            t.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+} // namespace vix::registry::storage
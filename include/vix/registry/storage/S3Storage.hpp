@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <vix/registry/storage/IPackageStore.hpp>
+#include <vix/registry/storage/S3Transport.hpp>
+
+namespace vix::registry::storage
+{
+    struct S3Config
+    {
+        std::string endpoint; // host name of the S3-compatible service
+        std::uint16_t port{80};
+        std::string region{"us-east-1"};
+        std::string bucket;
+        std::string accessKey;
+        std::string secretKey;
+
+        // Path-style (`host/bucket/key`, MinIO & co.) vs virtual-hosted
+        // (`bucket.host/key`, AWS).
+        bool pathStyle{true};
+
+        // Where clients reach the store for presigned downloads (CDN, public
+        // load balancer), when that differs from `endpoint`. Empty: use
+        // `endpoint`/`port`. Port 0 means the scheme's default.
+        std::string publicEndpoint;
+        std::uint16_t publicPort{0};
+
+        // Empty: https for `publicEndpoint`; for the internal endpoint, the
+        // scheme the transport speaks (http, https only on port 443).
+        std::string publicScheme;
+
+        std::size_t maxConnections{16};
+        std::size_t parallelism{8};
+        std::uint64_t partSize{8ull * 1024 * 1024};
+        std::uint64_t multipartThreshold{16ull * 1024 * 1024};
+    };
+
+    /**
+     * Artifacts in an S3-compatible bucket.
+     *
+     * Large uploads use multipart PUTs and large downloads use ranged GETs,
+     * both spread over `parallelism` workers sharing the transport's
+     * keep-alive pool. Clients are meant to download through presigned URLs
+     * (see downloadUrl()) so artifact bytes never transit the registry.
+     */
+    class S3Storage : public IPackageStore
+    {
+    public:
+        explicit S3Storage(S3Config config, std::shared_ptr<IS3Transport> transport = nullptr);
+
+        const S3Config &config() const noexcept { return config_; }
+
+        // Runtime-tunable transfer concurrency (config reload).
+        void setConcurrency(std::size_t parallelism, std::size_t maxConnections);
+        std::size_t parallelism() const noexcept { return parallelism_.load(std::memory_order_relaxed); }
+
+        void put(const std::string &key, std::string_view data) override;
+        void putFile(const std::string &key, const std::filesystem::path &source) override;
+
+        std::string read(const std::string &key,
+                         std::uint64_t offset,
+                         std::uint64_t length) override;
+        void getToFile(const std::string &key, const std::filesystem::path &target) override;
+
+        std::optional<std::uint64_t> size(const std::string &key) override;
+        void remove(const std::string &key) override;
+        void quarantine(const std::string &key) override;
+        std::size_t purgeStaleUploads(std::chrono::system_clock::time_point olderThan) override;
+
+        ObjectPage list(const std::string &prefix,
+                        const std::string &startAfter,
+                        std::size_t limit) override;
+
+        std::optional<std::string> downloadUrl(const std::string &key,
+                                               std::chrono::seconds ttl) override;
+
+        // Presigned GET URL (SigV4 query auth) as of `now`.
+        std::string presign(const std::string &key,
+                            std::chrono::seconds ttl,
+                            std::chrono::system_clock::time_point now) const;
+
+    private:
+        template <typename ReadPart>
+        void putMultipart(const std::string &key, std::uint64_t total, ReadPart readPart);
+
+        S3Response send(S3Request req, const std::string &payloadHash) const;
+        S3Request makeRequest(const std::string &method, const std::string &key) const;
+
+        std::string hostHeader() const;
+        std::string publicHost() const;
+        std::string publicScheme() const;
+        std::string objectPath(const std::string &key) const;
+        std::string bucketPath() const;
+
+        S3Config config_;
+        std::atomic<std::size_t> parallelism_{1};
+        std::shared_ptr<IS3Transport> transport_;
+    };
+} // namespace vix::registry::storage
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vix::registry::storage
+{
+    struct S3Request
+    {
+        std::string method;
+        std::string path;  // already URI-encoded, starts with '/'
+        std::string query; // canonical, already encoded, without '?'
+        std::vector<std::pair<std::string, std::string>> headers;
+        std::string body;
+    };
+
+    struct S3Response
+    {
+        int status{0};
+        std::vector<std::pair<std::string, std::string>> headers;
+        std::string body;
+
+        // Case-insensitive header lookup.
+        std::optional<std::string> header(const std::string &name) const;
+    };
+
+    /**
+     * Wire-level transport used by S3Storage. Implementations must be safe to
+     * call from several threads at once (parallel part transfers).
+     */
+    class IS3Transport
+    {
+    public:
+        virtual ~IS3Transport() = default;
+        virtual S3Response send(const S3Request &req) = 0;
+    };
+
+    struct HttpTransportConfig
+    {
+        std::string host;
+        std::uint16_t port{80};
+
+        std::size_t maxConnections{16};
+        std::chrono::milliseconds ioTimeout{30000};
+    };
+
+    /**
+     * HTTP/1.1 client with a bounded keep-alive connection pool.
+     *
+     * Connections are returned to the pool after each exchange unless the
+     * server asked to close. A request that fails on a reused (possibly
+     * stale) connection before any byte of the reply arrived is retried
+     * once on a fresh one, unless it is non-idempotent (POST) and was
+     * already written. TLS is expected to
+     * be terminated in front of the object store (sidecar / in-cluster
+     * endpoint).
+     */
+    class PooledHttpTransport : public IS3Transport
+    {
+    public:
+        explicit PooledHttpTransport(HttpTransportConfig config);
+        ~PooledHttpTransport() override;
+
+        PooledHttpTransport(const PooledHttpTransport &) = delete;
+        PooledHttpTransport &operator=(const PooledHttpTransport &) = delete;
+
+        S3Response send(const S3Request &req) override;
+
+        std::size_t idleConnections() const;
+
+        // Grows immediately; shrinking closes surplus connections as they
+        // are returned.
+        void setMaxConnections(std::size_t maxConnections);
+
+    private:
+        class Connection;
+
+        std::unique_ptr<Connection> acquire(bool &reused);
+        void release(std::unique_ptr<Connection> conn, bool keepAlive);
+        S3Response exchange(Connection &conn, const S3Request &req, bool &keepAlive);
+
+        HttpTransportConfig config_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable available_;
+        std::vector<std::unique_ptr<Connection>> idle_;
+        std::size_t open_{0};
+    };
+} // namespace vix::registry::storage
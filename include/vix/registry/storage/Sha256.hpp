@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace vix::registry::storage
+{
+    /**
+     * Incremental SHA-256 (FIPS 180-4).
+     *
+     * Used for artifact integrity (`versions.sha256`) and for AWS SigV4
+     * request signing in the S3 backend.
+     */
+    class Sha256
+    {
+    public:
+        using Digest = std::array<std::uint8_t, 32>;
+
+        Sha256() { reset(); }
+
+        void reset();
+        void update(const void *data, std::size_t len);
+        void update(std::string_view data) { update(data.data(), data.size()); }
+        Digest finish();
+
+        static Digest digest(std::string_view data);
+        static std::string hex(std::string_view data);
+        static std::string toHex(const Digest &d);
+
+    private:
+        void transform(const std::uint8_t *block);
+
+        std::array<std::uint32_t, 8> state_{};
+        std::array<std::uint8_t, 64> buffer_{};
+        std::size_t bufferLen_{0};
+        std::uint64_t totalLen_{0};
+    };
+
+    Sha256::Digest hmacSha256(std::string_view key, std::string_view data);
+} // namespace vix::registry::storage
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace vix::registry::trace
+{
+    enum class Stage : std::uint8_t
+    {
+        Auth,
+        Cache,
+        DbAcquire,
+        DbQuery,
+        Storage,
+        Serialize
+    };
+
+    inline constexpr std::size_t kStageCount = 6;
+
+    const char *stageName(Stage stage) noexcept;
+
+    struct SpanRecord
+    {
+        std::uint64_t traceSeq{0};
+        std::uint64_t startNs{0};
+        std::uint64_t durNs{0};
+        Stage stage{Stage::Auth};
+    };
+
+    /**
+     * Fixed-capacity span ring, one per thread. Only the owning thread
+     * writes or reads it, so no locking is involved; when a request records
+     * more than kCapacity spans the oldest ones are overwritten.
+     */
+    class SpanRing
+    {
+    public:
+        static constexpr std::size_t kCapacity = 1024; // power of two
+
+        static SpanRing &local() noexcept;
+
+        void push(const SpanRecord &r) noexcept
+        {
+            slots_[head_ & (kCapacity - 1)] = r;
+            ++head_;
+        }
+
+        std::uint64_t head() const noexcept { return head_; }
+
+        template <typename Fn>
+        void forEachSince(std::uint64_t from, Fn fn) const
+        {
+            if (head_ - from > kCapacity)
+                from = head_ - kCapacity;
+            for (std::uint64_t i = from; i < head_; ++i)
+                fn(slots_[i & (kCapacity - 1)]);
+        }
+
+    private:
+        std::array<SpanRecord, kCapacity> slots_{};
+        std::uint64_t head_{0};
+    };
+
+    struct TraceConfig
+    {
+        bool enabled = true;
+        bool serverTiming = true;
+
+        // Log one request in `sampleEvery` per thread (0 disables sampling);
+        // slow and 5xx requests are always logged.
+        std::uint32_t sampleEvery = 100;
+        std::chrono::milliseconds slowThreshold{500};
+    };
+
+    // Process-wide settings, safe to update while serving.
+    TraceConfig traceConfig();
+    void setTraceConfig(const TraceConfig &config);
+
+    /**
+     * Per-request trace: request id, monotonic start time and per-stage
+     * totals. While alive it is the thread's current trace, so lower layers
+     * record spans through ScopedSpan without any plumbing.
+     */
+    class RequestTrace
+    {
+    public:
+        RequestTrace(std::string method, std::string path, std::string requestId = {});
+        ~RequestTrace();
+
+        RequestTrace(const RequestTrace &) = delete;
+        RequestTrace &operator=(const RequestTrace &) = delete;
+
+        static RequestTrace *current() noexcept;
+        static std::uint64_t nowNs() noexcept;
+
+        const std::string &requestId() const noexcept { return requestId_; }
+        const std::string &method() const noexcept { return method_; }
+        const std::string &path() const noexcept { return path_; }
+
+        int status() const noexcept { return status_; }
+        void setStatus(int status) noexcept { status_ = status; }
+
+        void record(Stage stage, std::uint64_t startNs, std::uint64_t durNs) noexcept;
+
+        std::uint64_t elapsedNs() const noexcept { return nowNs() - startNs_; }
+        std::uint64_t stageNs(Stage stage) const noexcept { return stageNs_[static_cast<std::size_t>(stage)]; }
+
+        // `Server-Timing` header value, e.g. "db;dur=1.204, total;dur=3.870".
+        std::string serverTiming() const;
+
+        // One structured JSON log line (no trailing newline).
+        std::string toJson() const;
+
+        bool shouldLog(const TraceConfig &config) const noexcept;
+
+    private:
+        std::string method_;
+        std::string path_;
+        std::string requestId_;
+        int status_{200};
+
+        std::uint64_t seq_{0};
+        std::uint64_t startNs_{0};
+        std::uint64_t ringStart_{0};
+        std::array<std::uint64_t, kStageCount> stageNs_{};
+        std::array<std::uint32_t, kStageCount> stageCount_{};
+
+        RequestTrace *previous_{nullptr};
+    };
+
+    class ScopedSpan
+    {
+    public:
+        explicit ScopedSpan(Stage stage) noexcept
+            : trace_(RequestTrace::current()), stage_(stage),
+              startNs_(trace_ ? RequestTrace::nowNs() : 0)
+        {
+        }
+
+        ~ScopedSpan()
+        {
+            if (trace_)
+                trace_->record(stage_, startNs_, RequestTrace::nowNs() - startNs_);
+        }
+
+        ScopedSpan(const ScopedSpan &) = delete;
+        ScopedSpan &operator=(const ScopedSpan &) = delete;
+
+    private:
+        RequestTrace *trace_;
+        Stage stage_;
+        std::uint64_t startNs_;
+    };
+
+    std::string generateRequestId();
+
+    // Returns `incoming` if it is a safe client-supplied id, empty otherwise.
+    std::string sanitizeRequestId(std::string_view incoming);
+
+    // Writes the trace as one JSON line to stderr if it is sampled.
+    void emitTraceLog(const RequestTrace &trace);
+} // namespace vix::registry::trace
@@ -0,0 +1,5 @@
+-- 0003_index_artifact_path.sql
+-- Lets the storage scrubber map blobs back to versions without full scans
+
+ALTER TABLE versions
+    ADD KEY idx_versions_artifact_path (artifact_path);
@@ -1,5 +1,11 @@
 #include <vix/registry/App.hpp>
+#include <vix/registry/db/VersionArtifactIndex.hpp>
+#include <vix/registry/trace/Tracing.hpp>
+#include <vix/registry/storage/LocalFileStorage.hpp>
+#include <vix/registry/storage/S3Storage.hpp>
 
+#include <chrono>
+#include <csignal>
 #include <iostream>
 #include <cstdlib>
 #include <stdexcept>
@@ -35,8 +41,8 @@ namespace vix::registry
         dbCfg.user = user;
         dbCfg.password = pass;
         dbCfg.database = name;
-        dbCfg.poolMin = 1;
-        dbCfg.poolMax = 8;
+        dbCfg.poolMin = static_cast<std::size_t>(cfg.getInt("database.default.POOL_MIN", 1));
+        dbCfg.poolMax = static_cast<std::size_t>(cfg.getInt("database.default.POOL_MAX", 8));
         return dbCfg;
     }
 
@@ -52,13 +58,104 @@ namespace vix::registry
         return std::make_shared<db::Database>(dbCfg);
     }
 
+    static storage::S3Config makeS3ConfigFromFileConfig(const vix::config::Config &cfg)
+    {
+        storage::S3Config s3{};
+        s3.endpoint = cfg.getString("storage.s3.ENDPOINT", "localhost");
+        s3.port = static_cast<std::uint16_t>(cfg.getInt("storage.s3.PORT", 9000));
+        s3.region = cfg.getString("storage.s3.REGION", "us-east-1");
+        s3.bucket = cfg.getString("storage.s3.BUCKET", "registry-artifacts");
+        s3.accessKey = cfg.getString("storage.s3.ACCESS_KEY", "");
+        s3.secretKey = cfg.getString("storage.s3.SECRET_KEY", "");
+        s3.pathStyle = cfg.getString("storage.s3.ADDRESSING", "path") != "virtual";
+        s3.publicEndpoint = cfg.getString("storage.s3.PUBLIC_ENDPOINT", "");
+        s3.publicPort = static_cast<std::uint16_t>(cfg.getInt("storage.s3.PUBLIC_PORT", 0));
+        s3.publicScheme = cfg.getString("storage.s3.PUBLIC_SCHEME", "");
+        s3.maxConnections = static_cast<std::size_t>(cfg.getInt("storage.s3.MAX_CONNECTIONS", 16));
+        s3.parallelism = static_cast<std::size_t>(cfg.getInt("storage.s3.PARALLELISM", 8));
+        s3.partSize = static_cast<std::uint64_t>(cfg.getInt("storage.s3.PART_SIZE_MB", 8)) * 1024 * 1024;
+
+        if (const char *ak = std::getenv("REGISTRY_S3_ACCESS_KEY"); ak && *ak != '\0')
+            s3.accessKey = ak;
+        if (const char *sk = std::getenv("REGISTRY_S3_SECRET_KEY"); sk && *sk != '\0')
+            s3.secretKey = sk;
+        return s3;
+    }
+
+    static trace::TraceConfig makeTraceConfig(const vix::config::Config &cfg)
+    {
+        trace::TraceConfig traceCfg{};
+        traceCfg.enabled = cfg.getInt("tracing.ENABLED", 1) != 0;
+        traceCfg.serverTiming = cfg.getInt("tracing.SERVER_TIMING", 1) != 0;
+        traceCfg.sampleEvery = static_cast<std::uint32_t>(cfg.getInt("tracing.SAMPLE_EVERY", 100));
+        traceCfg.slowThreshold = std::chrono::milliseconds(cfg.getInt("tracing.SLOW_MS", 500));
+        return traceCfg;
+    }
+
+    static services::ScrubConfig makeScrubConfig(const vix::config::Config &cfg)
+    {
+        services::ScrubConfig scrubCfg{};
+        scrubCfg.pageSize = static_cast<std::size_t>(cfg.getInt("scrub.PAGE_SIZE", 500));
+        scrubCfg.hashWorkers = static_cast<std::size_t>(cfg.getInt("scrub.HASH_WORKERS", 0));
+        scrubCfg.maxBytesPerSecond = static_cast<std::uint64_t>(cfg.getInt("scrub.MAX_MB_PER_S", 64)) * 1024 * 1024;
+        scrubCfg.orphanGrace = std::chrono::seconds(cfg.getInt("scrub.ORPHAN_GRACE_S", 86400));
+        scrubCfg.uploadGrace = std::chrono::seconds(cfg.getInt("scrub.UPLOAD_GRACE_S", 86400));
+        scrubCfg.deleteOrphans = cfg.getInt("scrub.DELETE_ORPHANS", 0) != 0;
+        scrubCfg.maxOrphanPercent = static_cast<std::size_t>(cfg.getInt("scrub.MAX_ORPHAN_PCT", 50));
+        scrubCfg.interval = std::chrono::seconds(cfg.getInt("scrub.INTERVAL_S", 21600));
+        scrubCfg.checkpointPath = cfg.getString("scrub.CHECKPOINT", "");
+        return scrubCfg;
+    }
+
+    std::shared_ptr<storage::IPackageStore> App::initStorage(const vix::config::Config &cfg)
+    {
+        const std::string backend = cfg.getString("storage.backend", "local");
+        if (backend == "s3")
+            return std::make_shared<storage::S3Storage>(makeS3ConfigFromFileConfig(cfg));
+        if (backend != "local")
+            throw std::runtime_error("Unknown storage.backend: " + backend);
+
+        return std::make_shared<storage::LocalFileStorage>(
+            cfg.getString("storage.local.ROOT", "data/artifacts"));
+    }
+
     App::App()
         : config_(resolveConfigPath())
     {
+        // Before any worker thread exists, so they all inherit the mask and
+        // termination signals reach the watcher instead. The watcher starts
+        // right away: a startup stuck on the database must still be stoppable.
+        SignalWatcher::blockSignals();
+        signals_.on(SIGTERM, [this](int sig)
+                    { terminate(sig); });
+        signals_.on(SIGINT, [this](int sig)
+                    { terminate(sig); });
+        signals_.on(SIGHUP, [this](int)
+                    {
+            if (serving_.load())
+                reload(); });
+        signals_.start();
+
         port_ = static_cast<std::uint16_t>(config_.getInt("http.port", config_.getServerPort()));
+        drainTimeout_.store(std::chrono::milliseconds(config_.getInt("shutdown.DRAIN_TIMEOUT_MS", 30000)));
+        trace::setTraceConfig(makeTraceConfig(config_));
 
         db_ = initDatabase(config_);
-        server_ = std::make_unique<http::HttpServer>(port_, db_);
+        store_ = initStorage(config_);
+
+        auto artifactIndex = std::make_shared<db::VersionArtifactIndex>(db_);
+
+        server_ = std::make_unique<http::HttpServer>(
+            port_, db_, store_,
+            std::make_shared<services::DownloadService>(artifactIndex),
+            std::chrono::seconds(config_.getInt("storage.DOWNLOAD_URL_TTL", 300)));
+
+        if (config_.getInt("scrub.ENABLED", 0) != 0)
+        {
+            scrubber_ = std::make_shared<services::ArtifactScrubber>(
+                store_, artifactIndex, makeScrubConfig(config_));
+            server_->setScrubber(scrubber_);
+        }
     }
 
     App::~App() = default;
@@ -80,8 +177,98 @@ namespace vix::registry
             return 1;
         }
 
+        if (scrubber_)
+            scrubber_->start();
+
+        serving_.store(true);
         server_->run();
+
+        shutdown();
+        signals_.stop();
         return 0;
     }
 
+    void App::shutdown()
+    {
+        std::call_once(shutdownOnce_, [this]
+                       {
+            std::cout << "[registry] Shutting down, draining in-flight requests..." << std::endl;
+            server_->beginDrain();
+
+            // Interrupted passes resume from their checkpoint on next start.
+            if (scrubber_)
+                scrubber_->stop();
+
+            const auto deadline = std::chrono::steady_clock::now() + drainTimeout_.load();
+            if (!server_->waitDrained(deadline))
+            {
+                std::cerr << "[registry] Drain deadline reached with "
+                          << server_->inflight().inflight() << " request(s) still in flight." << std::endl;
+            }
+
+            server_->stop();
+            std::cout << "[registry] Shutdown complete." << std::endl; });
+    }
+
+    void App::terminate(int signal)
+    {
+        if (serving_.load())
+        {
+            shutdown();
+            return;
+        }
+
+        // Nothing is serving yet, so there is nothing to drain; the
+        // constructor or the connection test may be blocked indefinitely.
+        std::cerr << "[registry] Signal " << signal << " during startup, exiting." << std::endl;
+        std::_Exit(128 + signal);
+    }
+
+    void App::applyRuntimeConfig(const vix::config::Config &cfg)
+    {
+        trace::setTraceConfig(makeTraceConfig(cfg));
+        drainTimeout_.store(std::chrono::milliseconds(cfg.getInt("shutdown.DRAIN_TIMEOUT_MS", 30000)));
+        if (scrubber_)
+            scrubber_->reconfigure(makeScrubConfig(cfg));
+
+        // The ORM pool cannot be resized in place (see Database). Bounds from
+        // the environment (initDatabase) are not in the file at all.
+        const char *envHost = std::getenv("REGISTRY_DB_HOST");
+        if (!envHost || *envHost == '\0')
+        {
+            const auto current = db_->config();
+            const auto poolMin = cfg.getInt("database.default.POOL_MIN", static_cast<int>(current.poolMin));
+            const auto poolMax = cfg.getInt("database.default.POOL_MAX", static_cast<int>(current.poolMax));
+            if (static_cast<std::size_t>(poolMin) != current.poolMin ||
+                static_cast<std::size_t>(poolMax) != current.poolMax)
+            {
+                std::cerr << "[registry] database.default.POOL_MIN/POOL_MAX changed; "
+                          << "restart to resize the connection pool." << std::endl;
+            }
+        }
+
+        if (auto *s3 = dynamic_cast<storage::S3Storage *>(store_.get()))
+        {
+            s3->setConcurrency(
+                static_cast<std::size_t>(cfg.getInt("storage.s3.PARALLELISM", static_cast<int>(s3->parallelism()))),
+                static_cast<std::size_t>(cfg.getInt("storage.s3.MAX_CONNECTIONS",
+                                                    static_cast<int>(s3->config().maxConnections))));
+        }
+    }
+
+    void App::reload()
+    {
+        try
+        {
+            const vix::config::Config fresh(resolveConfigPath());
+            applyRuntimeConfig(fresh);
+            std::cout << "[registry] Configuration reloaded." << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[registry] Configuration reload FAILED, keeping current settings: "
+                      << e.what() << std::endl;
+        }
+    }
+
 } // namespace vix::registry
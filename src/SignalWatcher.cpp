@@ -0,0 +1,95 @@
+#include <vix/registry/SignalWatcher.hpp>
+
+#include <csignal>
+#include <iostream>
+
+#include <pthread.h>
+
+namespace vix::registry
+{
+    namespace
+    {
+        // Internal wake-up used by stop(); never exposed to handlers.
+        constexpr int kStopSignal = SIGUSR2;
+
+        sigset_t watchedSet()
+        {
+            sigset_t set;
+            sigemptyset(&set);
+            sigaddset(&set, SIGTERM);
+            sigaddset(&set, SIGINT);
+            sigaddset(&set, SIGHUP);
+            sigaddset(&set, kStopSignal);
+            return set;
+        }
+    } // namespace
+
+    SignalWatcher::~SignalWatcher()
+    {
+        stop();
+    }
+
+    void SignalWatcher::blockSignals()
+    {
+        const sigset_t set = watchedSet();
+        pthread_sigmask(SIG_BLOCK, &set, nullptr);
+    }
+
+    void SignalWatcher::on(int signal, Handler handler)
+    {
+        handlers_[signal] = std::move(handler);
+    }
+
+    void SignalWatcher::start()
+    {
+        if (thread_.joinable())
+            return;
+
+        // The watcher must start with the set blocked even if blockSignals()
+        // was not called, or stop()'s wake-up would hit the default action.
+        const sigset_t set = watchedSet();
+        sigset_t previous;
+        pthread_sigmask(SIG_BLOCK, &set, &previous);
+
+        thread_ = std::thread([this, set]
+                              {
+            for (;;)
+            {
+                int sig = 0;
+                if (sigwait(&set, &sig) != 0)
+                    continue;
+                if (sig == kStopSignal)
+                    return;
+
+                const auto it = handlers_.find(sig);
+                if (it == handlers_.end())
+                    continue;
+
+                try
+                {
+                    it->second(sig);
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "[registry] Signal " << sig << " handler failed: " << e.what() << std::endl;
+                }
+            } });
+
+        pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+    }
+
+    void SignalWatcher::stop()
+    {
+        if (!thread_.joinable())
+            return;
+
+        if (thread_.get_id() == std::this_thread::get_id())
+        {
+            thread_.detach();
+            return;
+        }
+
+        pthread_kill(thread_.native_handle(), kStopSignal);
+        thread_.join();
+    }
+} // namespace vix::registry
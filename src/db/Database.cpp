@@ -1,6 +1,8 @@
 #include "vix/registry/db/Database.hpp"
+#include "vix/registry/trace/Tracing.hpp"
 
 #include <cstdlib>
+#include <optional>
 #include <stdexcept>
 #include <string>
 
@@ -88,18 +90,26 @@ namespace vix::registry::db
 
     Database::UnitOfWork Database::makeUnitOfWork()
     {
+        trace::ScopedSpan span(trace::Stage::DbAcquire);
         return UnitOfWork{pool_};
     }
 
     Database::Transaction Database::makeTransaction()
     {
+        trace::ScopedSpan span(trace::Stage::DbAcquire);
         return Transaction{pool_};
     }
 
     void Database::testConnection()
     {
-        vix::orm::PooledConn pc(pool_);
-        auto &conn = pc.get();
+        std::optional<vix::orm::PooledConn> pc;
+        {
+            trace::ScopedSpan span(trace::Stage::DbAcquire);
+            pc.emplace(pool_);
+        }
+
+        trace::ScopedSpan span(trace::Stage::DbQuery);
+        auto &conn = pc->get();
         auto st = conn.prepare("SELECT 1");
         st->exec();
     }
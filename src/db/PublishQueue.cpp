@@ -0,0 +1,154 @@
+#include <vix/registry/db/PublishQueue.hpp>
+
+#include <exception>
+#include <utility>
+
+namespace vix::registry::db
+{
+    namespace
+    {
+        PublishQueueConfig normalized(PublishQueueConfig config)
+        {
+            if (config.maxBatch == 0)
+                config.maxBatch = 1;
+            if (config.maxPending < config.maxBatch)
+                config.maxPending = config.maxBatch;
+            return config;
+        }
+    } // namespace
+
+    PublishQueue::PublishQueue(std::shared_ptr<IVersionBatchWriter> writer, PublishQueueConfig config)
+        : writer_(std::move(writer)), config_(normalized(config))
+    {
+        committer_ = std::thread([this]
+                                 { committerLoop(); });
+    }
+
+    PublishQueue::~PublishQueue()
+    {
+        stop();
+    }
+
+    std::future<PublishResult> PublishQueue::enqueue(domain::Version version)
+    {
+        std::promise<PublishResult> promise;
+        auto future = promise.get_future();
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            hasRoom_.wait(lock, [this]
+                          { return stopping_ || queue_.size() < config_.maxPending; });
+
+            if (stopping_)
+            {
+                promise.set_value(PublishResult{PublishStatus::Failed, 0, "Publish queue is shutting down"});
+                return future;
+            }
+
+            queue_.push_back(Item{std::move(version), std::move(promise)});
+        }
+
+        hasWork_.notify_one();
+        return future;
+    }
+
+    void PublishQueue::reconfigure(PublishQueueConfig config)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_ = normalized(config);
+        }
+        hasRoom_.notify_all();
+        hasWork_.notify_all();
+    }
+
+    void PublishQueue::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+
+        hasWork_.notify_all();
+        hasRoom_.notify_all();
+
+        std::lock_guard<std::mutex> lock(joinMutex_);
+        if (committer_.joinable())
+            committer_.join();
+    }
+
+    std::size_t PublishQueue::pending() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+    std::uint64_t PublishQueue::batchesCommitted() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
+
+    void PublishQueue::committerLoop()
+    {
+        std::vector<Item> batch;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                hasWork_.wait(lock, [this]
+                              { return stopping_ || !queue_.empty(); });
+
+                if (queue_.empty())
+                    return; // stopping and fully drained
+
+                // Linger briefly so publishes arriving together share a batch.
+                if (!stopping_ && queue_.size() < config_.maxBatch && config_.maxDelay.count() > 0)
+                {
+                    hasWork_.wait_for(lock, config_.maxDelay, [this]
+                                      { return stopping_ || queue_.size() >= config_.maxBatch; });
+                }
+
+                while (!queue_.empty() && batch.size() < config_.maxBatch)
+                {
+                    batch.push_back(std::move(queue_.front()));
+                    queue_.pop_front();
+                }
+            }
+            hasRoom_.notify_all();
+
+            commit(batch);
+            batch.clear();
+        }
+    }
+
+    void PublishQueue::commit(std::vector<Item> &batch)
+    {
+        std::vector<domain::Version> rows;
+        rows.reserve(batch.size());
+        for (const auto &item : batch)
+            rows.push_back(item.version);
+
+        std::vector<PublishResult> results;
+        try
+        {
+            results = writer_->writeBatch(rows);
+        }
+        catch (const std::exception &e)
+        {
+            results.assign(batch.size(), PublishResult{PublishStatus::Failed, 0, e.what()});
+        }
+
+        if (results.size() != batch.size())
+            results.assign(batch.size(), PublishResult{PublishStatus::Failed, 0, "Batch writer returned a mismatched result count"});
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++batches_;
+        }
+
+        for (std::size_t i = 0; i < batch.size(); ++i)
+            batch[i].promise.set_value(std::move(results[i]));
+    }
+} // namespace vix::registry::db
@@ -0,0 +1,92 @@
+#include <vix/registry/db/VersionArtifactIndex.hpp>
+#include <vix/registry/trace/Tracing.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace vix::registry::db
+{
+    namespace
+    {
+        constexpr std::size_t kPathsPerStatement = 200;
+    } // namespace
+
+    VersionArtifactIndex::VersionArtifactIndex(std::shared_ptr<Database> db)
+        : db_(std::move(db))
+    {
+    }
+
+    std::unordered_map<std::string, ArtifactRecord>
+    VersionArtifactIndex::lookup(const std::vector<std::string> &artifactPaths)
+    {
+        std::unordered_map<std::string, ArtifactRecord> found;
+        if (artifactPaths.empty())
+            return found;
+
+        std::optional<vix::orm::PooledConn> pc;
+        {
+            trace::ScopedSpan span(trace::Stage::DbAcquire);
+            pc.emplace(db_->pool());
+        }
+
+        trace::ScopedSpan span(trace::Stage::DbQuery);
+        auto &conn = pc->get();
+
+        for (std::size_t start = 0; start < artifactPaths.size(); start += kPathsPerStatement)
+        {
+            const std::size_t n = std::min(kPathsPerStatement, artifactPaths.size() - start);
+
+            std::string sql = "SELECT artifact_path, sha256, size_bytes FROM versions WHERE artifact_path IN (";
+            for (std::size_t i = 0; i < n; ++i)
+                sql += (i == 0) ? "?" : ",?";
+            sql += ")";
+
+            auto st = conn.prepare(sql);
+            for (std::size_t i = 0; i < n; ++i)
+                st->bind(i + 1, artifactPaths[start + i]);
+
+            auto rs = st->query();
+            while (rs->next())
+            {
+                const auto &row = rs->row();
+                found.emplace(row.getString(0),
+                              ArtifactRecord{row.getString(1), static_cast<std::uint64_t>(row.getInt64(2))});
+            }
+        }
+        return found;
+    }
+
+    std::vector<VersionArtifact>
+    VersionArtifactIndex::findArtifacts(const std::string &packageName, const std::string &semver)
+    {
+        std::optional<vix::orm::PooledConn> pc;
+        {
+            trace::ScopedSpan span(trace::Stage::DbAcquire);
+            pc.emplace(db_->pool());
+        }
+
+        trace::ScopedSpan span(trace::Stage::DbQuery);
+        auto &conn = pc->get();
+
+        auto st = conn.prepare(
+            "SELECT v.artifact_path, v.sha256, v.size_bytes, v.yanked "
+            "FROM versions v JOIN packages p ON p.id = v.package_id "
+            "WHERE p.name = ? AND v.semver = ? AND p.visibility = 'public'");
+        st->bind(1, packageName);
+        st->bind(2, semver);
+
+        std::vector<VersionArtifact> rows;
+        auto rs = st->query();
+        while (rs->next())
+        {
+            const auto &row = rs->row();
+            rows.push_back(VersionArtifact{row.getString(0),
+                                           row.getString(1),
+                                           static_cast<std::uint64_t>(row.getInt64(2)),
+                                           row.getInt64(3) != 0});
+        }
+        return rows;
+    }
+} // namespace vix::registry::db
@@ -0,0 +1,226 @@
+#include <vix/registry/db/VersionBatchWriter.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace vix::registry::db
+{
+    namespace
+    {
+        // Keeps each statement well under max_allowed_packet / placeholder limits.
+        constexpr std::size_t kRowsPerStatement = 200;
+
+        using VersionKey = std::pair<std::uint64_t, std::string>;
+
+        VersionKey keyOf(const domain::Version &v)
+        {
+            return {v.packageId(), v.semver()};
+        }
+
+        // Grouped attempts before a batch that keeps losing lock conflicts
+        // falls back to row-by-row.
+        constexpr int kGroupedAttempts = 3;
+
+        // The ORM surfaces driver errors as plain exceptions, so match the
+        // server's message text. Error numbers are not matched on their own:
+        // they also turn up inside quoted values.
+        bool isDuplicateKey(const std::exception &e)
+        {
+            return std::string_view(e.what()).find("Duplicate entry") != std::string_view::npos;
+        }
+
+        // ER_LOCK_DEADLOCK (1213) and ER_LOCK_WAIT_TIMEOUT (1205): the
+        // transaction was rolled back and can simply be run again.
+        bool isLockConflict(const std::exception &e)
+        {
+            const std::string_view msg(e.what());
+            return msg.find("Deadlock found") != std::string_view::npos ||
+                   msg.find("Lock wait timeout exceeded") != std::string_view::npos;
+        }
+
+        std::string repeatGroup(const char *group, std::size_t n)
+        {
+            std::string out;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                if (i > 0)
+                    out += ',';
+                out += group;
+            }
+            return out;
+        }
+
+        // SELECT ... WHERE (package_id, semver) IN (...) over `keys`, chunked.
+        template <typename Conn, typename OnRow>
+        void selectByKeys(Conn &conn,
+                          const std::vector<VersionKey> &keys,
+                          const char *columns,
+                          const char *suffix,
+                          OnRow onRow)
+        {
+            for (std::size_t start = 0; start < keys.size(); start += kRowsPerStatement)
+            {
+                const std::size_t n = std::min(kRowsPerStatement, keys.size() - start);
+                auto st = conn.prepare(std::string("SELECT ") + columns +
+                                       " FROM versions WHERE (package_id, semver) IN (" +
+                                       repeatGroup("(?,?)", n) + ")" + suffix);
+
+                std::size_t idx = 1;
+                for (std::size_t i = start; i < start + n; ++i)
+                {
+                    st->bind(idx++, static_cast<std::int64_t>(keys[i].first));
+                    st->bind(idx++, keys[i].second);
+                }
+
+                auto rs = st->query();
+                while (rs->next())
+                    onRow(rs->row());
+            }
+        }
+    } // namespace
+
+    VersionBatchWriter::VersionBatchWriter(std::shared_ptr<Database> db)
+        : db_(std::move(db))
+    {
+    }
+
+    std::vector<PublishResult> VersionBatchWriter::writeBatch(const std::vector<domain::Version> &batch)
+    {
+        if (batch.empty())
+            return {};
+
+        for (int attempt = 1;; ++attempt)
+        {
+            try
+            {
+                return writeGrouped(batch);
+            }
+            catch (const std::exception &e)
+            {
+                if (!isLockConflict(e) || attempt == kGroupedAttempts)
+                    break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10 * attempt));
+        }
+
+        // The grouped transaction was rolled back: a lost unique-key race, a
+        // row the server rejects (foreign key, data too long) or lock
+        // conflicts that outlasted the retries. Replay each row on its own so
+        // only the callers whose row is at fault see the failure.
+        std::vector<PublishResult> results;
+        results.reserve(batch.size());
+        for (const auto &v : batch)
+            results.push_back(writeOne(v));
+        return results;
+    }
+
+    std::vector<PublishResult> VersionBatchWriter::writeGrouped(const std::vector<domain::Version> &batch)
+    {
+        std::vector<PublishResult> results(batch.size());
+
+        // First occurrence of a (package_id, semver) in the batch wins.
+        std::map<VersionKey, std::size_t> firstIndex;
+        std::vector<VersionKey> uniqueKeys;
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            auto [it, inserted] = firstIndex.emplace(keyOf(batch[i]), i);
+            if (inserted)
+                uniqueKeys.push_back(it->first);
+            else
+                results[i] = PublishResult{PublishStatus::Conflict, 0, "Version already published: " + batch[i].semver()};
+        }
+
+        auto tx = db_->makeTransaction();
+        auto &conn = tx.conn();
+
+        std::set<VersionKey> existing;
+        selectByKeys(conn, uniqueKeys, "package_id, semver", "", [&](const auto &row)
+                     { existing.emplace(static_cast<std::uint64_t>(row.getInt64(0)), row.getString(1)); });
+
+        std::vector<std::size_t> toInsert;
+        std::vector<VersionKey> insertedKeys;
+        for (const auto &key : uniqueKeys)
+        {
+            const std::size_t i = firstIndex.at(key);
+            if (existing.count(key))
+            {
+                results[i] = PublishResult{PublishStatus::Conflict, 0, "Version already published: " + key.second};
+                continue;
+            }
+            toInsert.push_back(i);
+            insertedKeys.push_back(key);
+        }
+
+        for (std::size_t start = 0; start < toInsert.size(); start += kRowsPerStatement)
+        {
+            const std::size_t n = std::min(kRowsPerStatement, toInsert.size() - start);
+            auto st = conn.prepare(
+                "INSERT INTO versions (package_id, semver, artifact_path, sha256, size_bytes, yanked) VALUES " +
+                repeatGroup("(?,?,?,?,?,?)", n));
+
+            std::size_t idx = 1;
+            for (std::size_t j = start; j < start + n; ++j)
+            {
+                const auto &v = batch[toInsert[j]];
+                st->bind(idx++, static_cast<std::int64_t>(v.packageId()));
+                st->bind(idx++, v.semver());
+                st->bind(idx++, v.artifactPath());
+                st->bind(idx++, v.sha256());
+                st->bind(idx++, static_cast<std::int64_t>(v.sizeBytes()));
+                st->bind(idx++, static_cast<std::int64_t>(v.yanked() ? 1 : 0));
+            }
+            st->exec();
+        }
+
+        // Auto-increment ids of a multi-row INSERT are not guaranteed to be
+        // contiguous (innodb_autoinc_lock_mode=2), so read them back.
+        selectByKeys(conn, insertedKeys, "id, package_id, semver", "", [&](const auto &row)
+                     {
+            const VersionKey key{static_cast<std::uint64_t>(row.getInt64(1)), row.getString(2)};
+            const auto it = firstIndex.find(key);
+            if (it != firstIndex.end())
+                results[it->second] = PublishResult{PublishStatus::Committed,
+                                                    static_cast<std::uint64_t>(row.getInt64(0)), ""}; });
+
+        tx.commit();
+        return results;
+    }
+
+    PublishResult VersionBatchWriter::writeOne(const domain::Version &v)
+    {
+        try
+        {
+            auto tx = db_->makeTransaction();
+            auto &conn = tx.conn();
+
+            auto st = conn.prepare(
+                "INSERT INTO versions (package_id, semver, artifact_path, sha256, size_bytes, yanked) "
+                "VALUES (?,?,?,?,?,?)");
+            st->bind(1, static_cast<std::int64_t>(v.packageId()));
+            st->bind(2, v.semver());
+            st->bind(3, v.artifactPath());
+            st->bind(4, v.sha256());
+            st->bind(5, static_cast<std::int64_t>(v.sizeBytes()));
+            st->bind(6, static_cast<std::int64_t>(v.yanked() ? 1 : 0));
+            st->exec();
+
+            const auto id = static_cast<std::uint64_t>(conn.lastInsertId());
+            tx.commit();
+            return PublishResult{PublishStatus::Committed, id, ""};
+        }
+        catch (const std::exception &e)
+        {
+            if (isDuplicateKey(e))
+                return PublishResult{PublishStatus::Conflict, 0, "Version already published: " + v.semver()};
+            return PublishResult{PublishStatus::Failed, 0, e.what()};
+        }
+    }
+} // namespace vix::registry::db
@@ -1 +1,80 @@
 #include "vix/registry/domain/Version.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+
+namespace vix::registry::domain
+{
+    namespace
+    {
+        bool isDigits(std::string_view s) noexcept
+        {
+            if (s.empty())
+                return false;
+            for (char c : s)
+            {
+                if (!std::isdigit(static_cast<unsigned char>(c)))
+                    return false;
+            }
+            return true;
+        }
+
+        bool isNumericIdentifier(std::string_view s) noexcept
+        {
+            return isDigits(s) && (s.size() == 1 || s.front() != '0');
+        }
+
+        // Dot-separated, non-empty [0-9A-Za-z-] identifiers.
+        bool isIdentifierList(std::string_view s, bool numericNoLeadingZero) noexcept
+        {
+            std::size_t start = 0;
+            while (true)
+            {
+                const std::size_t end = std::min(s.find('.', start), s.size());
+                const std::string_view id = s.substr(start, end - start);
+                if (id.empty())
+                    return false;
+                for (char c : id)
+                {
+                    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-')
+                        return false;
+                }
+                if (numericNoLeadingZero && isDigits(id) && !isNumericIdentifier(id))
+                    return false;
+                if (end == s.size())
+                    return true;
+                start = end + 1;
+            }
+        }
+    } // namespace
+
+    bool isValidSemver(std::string_view semver) noexcept
+    {
+        std::string_view core = semver;
+
+        if (const auto plus = core.find('+'); plus != std::string_view::npos)
+        {
+            if (!isIdentifierList(core.substr(plus + 1), false))
+                return false;
+            core = core.substr(0, plus);
+        }
+        if (const auto dash = core.find('-'); dash != std::string_view::npos)
+        {
+            if (!isIdentifierList(core.substr(dash + 1), true))
+                return false;
+            core = core.substr(0, dash);
+        }
+
+        for (int part = 0; part < 3; ++part)
+        {
+            const auto dot = core.find('.');
+            if ((part < 2) != (dot != std::string_view::npos))
+                return false;
+            if (!isNumericIdentifier(core.substr(0, dot)))
+                return false;
+            core = (part < 2) ? core.substr(dot + 1) : std::string_view{};
+        }
+        return true;
+    }
+} // namespace vix::registry::domain
@@ -0,0 +1,33 @@
+#include <vix/registry/http/ArtifactStream.hpp>
+
+#include <algorithm>
+
+#include <vix/registry/domain/errors.hpp>
+#include <vix/registry/trace/Tracing.hpp>
+
+namespace vix::registry::http
+{
+    void streamArtifact(storage::IPackageStore &store,
+                        const std::string &key,
+                        std::uint64_t size,
+                        const std::function<void(std::string_view)> &write,
+                        std::uint64_t chunk)
+    {
+        chunk = std::max<std::uint64_t>(1, chunk);
+
+        std::uint64_t offset = 0;
+        while (offset < size)
+        {
+            std::string data;
+            {
+                trace::ScopedSpan span(trace::Stage::Storage);
+                data = store.read(key, offset, std::min(chunk, size - offset));
+            }
+            if (data.empty())
+                throw domain::StorageError("Artifact truncated at byte " + std::to_string(offset) + ": " + key);
+
+            offset += data.size();
+            write(data);
+        }
+    }
+} // namespace vix::registry::http
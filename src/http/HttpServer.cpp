@@ -1,30 +1,164 @@
 #include <vix/registry/http/HttpServer.hpp>
+#include <vix/registry/http/ArtifactStream.hpp>
+#include <vix/registry/http/Middleware.hpp>
+#include <vix/registry/domain/errors.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
 
 namespace vix::registry::http
 {
     HttpServer::HttpServer(std::uint16_t port,
-                           std::shared_ptr<vix::registry::db::Database> db)
-        : port_(port), db_(std::move(db))
+                           std::shared_ptr<vix::registry::db::Database> db,
+                           std::shared_ptr<vix::registry::storage::IPackageStore> store,
+                           std::shared_ptr<vix::registry::services::DownloadService> downloads,
+                           std::chrono::seconds downloadTtl)
+        : port_(port),
+          db_(std::move(db)),
+          store_(std::move(store)),
+          downloads_(std::move(downloads)),
+          downloadTtl_(downloadTtl)
+    {
+    }
+
+    // Counts the request as in-flight for the drain, or rejects it once
+    // shutdown has started.
+    template <typename Handler>
+    auto HttpServer::admitted(Handler handler)
     {
+        return traced([this, handler = std::move(handler)](auto &req, auto &res)
+                      {
+            auto guard = inflight_.tryEnter();
+            if (!guard) {
+                res.header("Connection", "close");
+                res.header("Retry-After", "1");
+                withStatus(res, 503).json(vix::json::kv({{"code", "SHUTTING_DOWN"}, {"message", "Server is draining"}}));
+                return;
+            }
+            handler(req, res); });
     }
 
     void HttpServer::setupRoutes()
     {
-        app_.get("/health", [](auto &, auto &res)
-                 { res.json({"status", "ok"}); });
+        // Turns red as soon as draining starts so the load balancer stops
+        // routing new traffic here.
+        app_.get("/health", traced([this](auto &, auto &res)
+                                   {
+            if (inflight_.draining()) {
+                withStatus(res, 503).json({"status", "draining"});
+                return;
+            }
+            res.json({"status", "ok"}); }));
 
-        app_.get("/", [](auto &, auto &res)
-                 { res.json({"message", "Vix Registry is running"}); });
+        app_.get("/", admitted([](auto &, auto &res)
+                               { res.json({"message", "Vix Registry is running"}); }));
 
-        app_.get("/health/db", [this](auto &, auto &res)
-                 {
+        app_.get("/health/db", admitted([this](auto &, auto &res)
+                                        {
             try {
                 if (!db_) throw std::runtime_error("Database not configured");
                 db_->testConnection();
+                trace::ScopedSpan span(trace::Stage::Serialize);
                 res.json({"db", "ok"});
             } catch (const std::exception &e) {
-                res.status(500).json(vix::json::kv({{"db", "error"}, {"message", e.what()}}));
-            } });
+                withStatus(res, 500).json(vix::json::kv({{"db", "error"}, {"message", e.what()}}));
+            } }));
+
+        app_.get("/metrics/scrub", admitted([this](auto &, auto &res)
+                                            {
+            if (!scrubber_) {
+                withStatus(res, 404).json(vix::json::kv({{"code", "SCRUBBER_DISABLED"}, {"message", "Storage scrubber is not enabled"}}));
+                return;
+            }
+
+            const auto s = scrubber_->stats();
+            trace::ScopedSpan span(trace::Stage::Serialize);
+            res.json(vix::json::kv({{"running", s.running},
+                                    {"cursor", s.cursor},
+                                    {"passes_completed", static_cast<long long>(s.passesCompleted)},
+                                    {"objects_scanned", static_cast<long long>(s.objectsScanned)},
+                                    {"bytes_verified", static_cast<long long>(s.bytesVerified)},
+                                    {"verified", static_cast<long long>(s.verified)},
+                                    {"corrupt", static_cast<long long>(s.corrupt)},
+                                    {"quarantined", static_cast<long long>(s.quarantined)},
+                                    {"orphans_found", static_cast<long long>(s.orphansFound)},
+                                    {"orphans_deleted", static_cast<long long>(s.orphansDeleted)},
+                                    {"orphan_bytes_freed", static_cast<long long>(s.orphanBytesFreed)},
+                                    {"orphan_deletes_skipped", static_cast<long long>(s.orphanDeletesSkipped)},
+                                    {"stale_uploads_purged", static_cast<long long>(s.staleUploadsPurged)},
+                                    {"errors", static_cast<long long>(s.errors)},
+                                    {"last_pass_ms", static_cast<long long>(s.lastPassDuration.count())},
+                                    {"last_error", s.lastError}})); }));
+
+        // Backends that can issue URLs redirect the client to a short-lived
+        // one; the others (local) are streamed through the registry.
+        app_.get("/v1/artifacts/{name}/{version}/{file}", admitted([this](auto &req, auto &res)
+                                                                   {
+            using namespace vix::registry::domain;
+            services::ResolvedArtifact artifact;
+            std::uint64_t size = 0;
+            try {
+                if (!store_ || !downloads_) throw std::runtime_error("Storage not configured");
+
+                // The index spans its own pool wait and query.
+                artifact = downloads_->resolve(std::string(req.param("name")),
+                                               std::string(req.param("version")),
+                                               std::string(req.param("file")));
+
+                std::optional<std::string> url;
+                {
+                    trace::ScopedSpan span(trace::Stage::Storage);
+                    url = store_->downloadUrl(artifact.key, downloadTtl_);
+                    if (!url) {
+                        const auto stored = store_->size(artifact.key);
+                        if (!stored)
+                            throw NotFoundError("Artifact missing from storage: " + artifact.key);
+                        size = *stored;
+                    }
+                }
+
+                if (url) {
+                    trace::ScopedSpan span(trace::Stage::Serialize);
+                    res.header("Location", *url);
+                    res.header("Cache-Control", "no-store");
+                    withStatus(res, 302).json(vix::json::kv({{"location", *url}}));
+                    return;
+                }
+            } catch (const ValidationError &e) {
+                withStatus(res, 400).json(vix::json::kv({{"code", "VALIDATION_ERROR"}, {"message", e.what()}}));
+                return;
+            } catch (const NotFoundError &e) {
+                withStatus(res, 404).json(vix::json::kv({{"code", "NOT_FOUND"}, {"message", e.what()}}));
+                return;
+            } catch (const ConflictError &e) {
+                withStatus(res, 409).json(vix::json::kv({{"code", "AMBIGUOUS_PACKAGE"}, {"message", e.what()}}));
+                return;
+            } catch (const GoneError &e) {
+                withStatus(res, 410).json(vix::json::kv({{"code", "VERSION_YANKED"}, {"message", e.what()}}));
+                return;
+            } catch (const std::exception &e) {
+                withStatus(res, 500).json(vix::json::kv({{"code", "INTERNAL_ERROR"}, {"message", e.what()}}));
+                return;
+            }
+
+            // Written chunk by chunk from inside the handler, so memory stays
+            // at one chunk per download and the in-flight guard covers the
+            // whole body. Once the headers are out a failure can only abort
+            // the connection, so it propagates to the framework.
+            res.header("Content-Type", "application/octet-stream");
+            res.header("Content-Length", std::to_string(size));
+            res.header("ETag", "\"" + artifact.sha256 + "\"");
+            withStatus(res, 200);
+            streamArtifact(*store_, artifact.key, size, [&res](std::string_view chunk)
+                           { res.write(chunk); });
+            res.end(); }));
+    }
+
+    void HttpServer::setScrubber(std::shared_ptr<vix::registry::services::ArtifactScrubber> scrubber)
+    {
+        scrubber_ = std::move(scrubber);
     }
 
     void HttpServer::initRoutes()
@@ -40,4 +174,20 @@ namespace vix::registry::http
         initRoutes();
         app_.run(port_);
     }
+
+    void HttpServer::beginDrain()
+    {
+        inflight_.beginDrain();
+    }
+
+    bool HttpServer::waitDrained(std::chrono::steady_clock::time_point deadline)
+    {
+        return inflight_.waitIdle(deadline);
+    }
+
+    void HttpServer::stop()
+    {
+        inflight_.beginDrain();
+        app_.close();
+    }
 }
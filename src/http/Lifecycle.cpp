@@ -0,0 +1,38 @@
+#include <vix/registry/http/Lifecycle.hpp>
+
+namespace vix::registry::http
+{
+    std::optional<InflightTracker::Guard> InflightTracker::tryEnter()
+    {
+        // Count first, then check: a request that slips in while beginDrain()
+        // runs is either refused here or seen by waitIdle().
+        inflight_.fetch_add(1, std::memory_order_acq_rel);
+        if (draining())
+        {
+            leave();
+            return std::nullopt;
+        }
+        return std::optional<Guard>(std::in_place, this);
+    }
+
+    void InflightTracker::beginDrain()
+    {
+        draining_.store(true, std::memory_order_release);
+    }
+
+    void InflightTracker::leave()
+    {
+        if (inflight_.fetch_sub(1, std::memory_order_acq_rel) == 1 && draining())
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle_.notify_all();
+        }
+    }
+
+    bool InflightTracker::waitIdle(std::chrono::steady_clock::time_point deadline)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return idle_.wait_until(lock, deadline, [this]
+                                { return inflight() == 0; });
+    }
+} // namespace vix::registry::http
@@ -0,0 +1 @@
+#include "vix/registry/http/Middleware.hpp"
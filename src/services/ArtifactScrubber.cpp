@@ -0,0 +1,424 @@
+#include <vix/registry/services/ArtifactScrubber.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <fstream>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#include <vix/registry/domain/errors.hpp>
+#include <vix/registry/storage/Parallel.hpp>
+#include <vix/registry/storage/Sha256.hpp>
+
+namespace vix::registry::services
+{
+    namespace fs = std::filesystem;
+
+    namespace
+    {
+        constexpr std::uint64_t kReadChunk = 4ull * 1024 * 1024;
+        constexpr std::chrono::milliseconds kCancelPoll{50};
+
+        bool sameDigest(const std::string &a, const std::string &b)
+        {
+            return a.size() == b.size() &&
+                   std::equal(a.begin(), a.end(), b.begin(), [](char x, char y)
+                              { return std::tolower(static_cast<unsigned char>(x)) ==
+                                       std::tolower(static_cast<unsigned char>(y)); });
+        }
+    } // namespace
+
+    ByteRateLimiter::ByteRateLimiter(std::uint64_t bytesPerSecond)
+        : bytesPerSecond_(bytesPerSecond)
+    {
+    }
+
+    bool ByteRateLimiter::acquire(std::uint64_t bytes, const std::atomic<bool> &cancelled)
+    {
+        if (bytesPerSecond_ == 0)
+            return !cancelled.load();
+
+        Clock::time_point wakeAt;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto now = Clock::now();
+            if (next_ < now - std::chrono::seconds(1))
+                next_ = now - std::chrono::seconds(1);
+            next_ += std::chrono::nanoseconds(static_cast<std::int64_t>(
+                static_cast<double>(bytes) * 1e9 / static_cast<double>(bytesPerSecond_)));
+            wakeAt = next_;
+        }
+
+        for (auto now = Clock::now(); now < wakeAt; now = Clock::now())
+        {
+            if (cancelled.load())
+                return false;
+            std::this_thread::sleep_for(std::min<Clock::duration>(wakeAt - now, kCancelPoll));
+        }
+        return !cancelled.load();
+    }
+
+    ArtifactScrubber::ArtifactScrubber(std::shared_ptr<storage::IPackageStore> store,
+                                       std::shared_ptr<db::IArtifactIndex> index,
+                                       ScrubConfig config)
+        : store_(std::move(store)), index_(std::move(index)), config_(std::move(config))
+    {
+    }
+
+    ArtifactScrubber::~ArtifactScrubber()
+    {
+        stop();
+    }
+
+    void ArtifactScrubber::start()
+    {
+        std::lock_guard<std::mutex> lock(joinMutex_);
+        if (worker_.joinable() || stopping_.load())
+            return;
+        worker_ = std::thread([this]
+                              { backgroundLoop(); });
+    }
+
+    void ArtifactScrubber::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_.store(true);
+        }
+        wake_.notify_all();
+
+        std::lock_guard<std::mutex> lock(joinMutex_);
+        if (worker_.joinable())
+            worker_.join();
+    }
+
+    void ArtifactScrubber::reconfigure(ScrubConfig config)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_ = std::move(config);
+        }
+        wake_.notify_all();
+    }
+
+    void ArtifactScrubber::backgroundLoop()
+    {
+        while (!stopping_.load())
+        {
+            runPass();
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, config_.interval, [this]
+                           { return stopping_.load(); });
+        }
+    }
+
+    bool ArtifactScrubber::runPass()
+    {
+        std::lock_guard<std::mutex> pass(passMutex_);
+        if (stopping_.load())
+            return false;
+
+        ScrubConfig config;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config = config_;
+            running_ = true;
+        }
+        if (!cursorLoaded_)
+        {
+            loadCursor(config);
+            cursorLoaded_ = true;
+        }
+
+        const auto started = std::chrono::steady_clock::now();
+        try
+        {
+            counters_.staleUploadsPurged +=
+                store_->purgeStaleUploads(std::chrono::system_clock::now() - config.uploadGrace);
+        }
+        catch (const std::exception &e)
+        {
+            recordError(std::string("purging stale uploads: ") + e.what());
+        }
+
+        ByteRateLimiter limiter(config.maxBytesPerSecond);
+        std::string cursor;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cursor = cursor_;
+        }
+
+        bool completed = false;
+        while (!stopping_.load())
+        {
+            storage::ObjectPage page;
+            try
+            {
+                page = store_->list("", cursor, std::max<std::size_t>(1, config.pageSize));
+            }
+            catch (const std::exception &e)
+            {
+                recordError(std::string("listing after '") + cursor + "': " + e.what());
+                break;
+            }
+
+            scrubPage(page.objects, config, limiter);
+
+            // An interrupted page is redone from the start next time.
+            if (stopping_.load())
+                break;
+            if (!page.nextStartAfter)
+            {
+                completed = true;
+                break;
+            }
+            cursor = *page.nextStartAfter;
+            saveCursor(config, cursor);
+        }
+
+        if (completed)
+            saveCursor(config, "");
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+        if (completed)
+        {
+            ++passesCompleted_;
+            lastPassDuration_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started);
+        }
+        return completed;
+    }
+
+    void ArtifactScrubber::scrubPage(const std::vector<storage::ObjectInfo> &objects,
+                                     const ScrubConfig &config,
+                                     ByteRateLimiter &limiter)
+    {
+        if (objects.empty())
+            return;
+        counters_.objectsScanned += objects.size();
+
+        std::vector<std::string> keys;
+        keys.reserve(objects.size());
+        for (const auto &o : objects)
+            keys.push_back(o.key);
+
+        // Without the index nothing can be told apart from an orphan, so the
+        // page is left alone.
+        std::unordered_map<std::string, db::ArtifactRecord> records;
+        try
+        {
+            records = index_->lookup(keys);
+        }
+        catch (const std::exception &e)
+        {
+            recordError(std::string("artifact index lookup: ") + e.what());
+            return;
+        }
+
+        // An orphan of unknown age may be a publish still in flight, so it is
+        // never collected.
+        const auto orphanCutoff = std::chrono::system_clock::now() - config.orphanGrace;
+        std::vector<const storage::ObjectInfo *> referenced;
+        std::vector<storage::ObjectInfo> orphans;
+        for (const auto &o : objects)
+        {
+            if (records.count(o.key))
+                referenced.push_back(&o);
+            else if (o.lastModified && *o.lastModified < orphanCutoff)
+                orphans.push_back(o);
+        }
+
+        const std::size_t workers = config.hashWorkers != 0
+                                        ? config.hashWorkers
+                                        : std::max(1u, std::thread::hardware_concurrency());
+
+        storage::runParallel(referenced.size(), workers, [&](std::size_t i)
+                             {
+            const auto &object = *referenced[i];
+            try {
+                switch (verify(object, records.at(object.key), limiter)) {
+                case Verdict::Intact:
+                    ++counters_.verified;
+                    break;
+                case Verdict::Corrupt:
+                    ++counters_.corrupt;
+                    store_->quarantine(object.key);
+                    ++counters_.quarantined;
+                    break;
+                case Verdict::Skipped:
+                    break;
+                }
+            } catch (const domain::NotFoundError &) {
+                // Removed since it was listed.
+            } catch (const std::exception &e) {
+                recordError(object.key + ": " + e.what());
+            } });
+
+        if (orphans.empty())
+            return;
+        counters_.orphansFound += orphans.size();
+        if (!config.deleteOrphans || stopping_.load())
+            return;
+
+        if (orphans.size() * 100 > objects.size() * config.maxOrphanPercent)
+        {
+            counters_.orphanDeletesSkipped += orphans.size();
+            recordError(std::to_string(orphans.size()) + " of " + std::to_string(objects.size()) +
+                        " objects after '" + objects.front().key + "' look orphaned; not deleting them");
+            return;
+        }
+        deleteOrphans(orphans);
+    }
+
+    ArtifactScrubber::Verdict ArtifactScrubber::verify(const storage::ObjectInfo &object,
+                                                       const db::ArtifactRecord &record,
+                                                       ByteRateLimiter &limiter)
+    {
+        // size_bytes defaults to 0 for rows that never recorded it.
+        if (record.sizeBytes != 0 && object.sizeBytes != record.sizeBytes)
+            return Verdict::Corrupt;
+
+        storage::Sha256 sha;
+        std::uint64_t offset = 0;
+        while (offset < object.sizeBytes)
+        {
+            const std::uint64_t n = std::min(kReadChunk, object.sizeBytes - offset);
+            if (!limiter.acquire(n, stopping_))
+                return Verdict::Skipped;
+
+            const std::string chunk = store_->read(object.key, offset, n);
+            if (chunk.empty())
+                break;
+            sha.update(chunk);
+            offset += chunk.size();
+            counters_.bytesVerified += chunk.size();
+        }
+
+        if (offset != object.sizeBytes)
+            return Verdict::Corrupt;
+        return sameDigest(storage::Sha256::toHex(sha.finish()), record.sha256) ? Verdict::Intact
+                                                                                : Verdict::Corrupt;
+    }
+
+    void ArtifactScrubber::deleteOrphans(const std::vector<storage::ObjectInfo> &candidates)
+    {
+        // Hashing the page can take a while: re-check so a version committed
+        // in the meantime keeps its blob.
+        std::vector<std::string> keys;
+        keys.reserve(candidates.size());
+        for (const auto &c : candidates)
+            keys.push_back(c.key);
+
+        std::unordered_map<std::string, db::ArtifactRecord> stillReferenced;
+        try
+        {
+            stillReferenced = index_->lookup(keys);
+        }
+        catch (const std::exception &e)
+        {
+            recordError(std::string("artifact index lookup: ") + e.what());
+            return;
+        }
+
+        for (const auto &c : candidates)
+        {
+            if (stopping_.load())
+                return;
+            if (stillReferenced.count(c.key))
+                continue;
+            try
+            {
+                store_->remove(c.key);
+                ++counters_.orphansDeleted;
+                counters_.orphanBytesFreed += c.sizeBytes;
+            }
+            catch (const std::exception &e)
+            {
+                recordError(c.key + ": " + e.what());
+            }
+        }
+    }
+
+    void ArtifactScrubber::loadCursor(const ScrubConfig &config)
+    {
+        if (config.checkpointPath.empty())
+            return;
+
+        std::ifstream in(config.checkpointPath);
+        std::string cursor;
+        if (!in || !std::getline(in, cursor))
+            return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        cursor_ = std::move(cursor);
+    }
+
+    void ArtifactScrubber::saveCursor(const ScrubConfig &config, const std::string &cursor)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cursor_ = cursor;
+        }
+        if (config.checkpointPath.empty())
+            return;
+
+        std::error_code ec;
+        if (cursor.empty())
+        {
+            fs::remove(config.checkpointPath, ec);
+            return;
+        }
+
+        fs::path tmp = config.checkpointPath;
+        tmp += ".tmp";
+        if (tmp.has_parent_path())
+            fs::create_directories(tmp.parent_path(), ec);
+        {
+            std::ofstream out(tmp, std::ios::trunc);
+            out << cursor << '\n';
+            if (!out)
+            {
+                recordError("cannot write scrub checkpoint " + tmp.string());
+                return;
+            }
+        }
+        fs::rename(tmp, config.checkpointPath, ec);
+        if (ec)
+            recordError("cannot write scrub checkpoint " + config.checkpointPath.string() + ": " + ec.message());
+    }
+
+    void ArtifactScrubber::recordError(const std::string &message)
+    {
+        ++counters_.errors;
+        std::lock_guard<std::mutex> lock(mutex_);
+        lastError_ = message;
+    }
+
+    ScrubStats ArtifactScrubber::stats() const
+    {
+        ScrubStats s;
+        s.objectsScanned = counters_.objectsScanned.load();
+        s.bytesVerified = counters_.bytesVerified.load();
+        s.verified = counters_.verified.load();
+        s.corrupt = counters_.corrupt.load();
+        s.quarantined = counters_.quarantined.load();
+        s.orphansFound = counters_.orphansFound.load();
+        s.orphansDeleted = counters_.orphansDeleted.load();
+        s.orphanBytesFreed = counters_.orphanBytesFreed.load();
+        s.orphanDeletesSkipped = counters_.orphanDeletesSkipped.load();
+        s.staleUploadsPurged = counters_.staleUploadsPurged.load();
+        s.errors = counters_.errors.load();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        s.running = running_;
+        s.cursor = cursor_;
+        s.passesCompleted = passesCompleted_;
+        s.lastPassDuration = lastPassDuration_;
+        s.lastError = lastError_;
+        return s;
+    }
+} // namespace vix::registry::services
@@ -0,0 +1,51 @@
+#include <vix/registry/services/DownloadService.hpp>
+
+#include <utility>
+#include <vector>
+
+#include <vix/registry/domain/errors.hpp>
+
+namespace vix::registry::services
+{
+    namespace
+    {
+        std::string fileName(const std::string &artifactPath)
+        {
+            const auto slash = artifactPath.rfind('/');
+            return slash == std::string::npos ? artifactPath : artifactPath.substr(slash + 1);
+        }
+    } // namespace
+
+    DownloadService::DownloadService(std::shared_ptr<db::IVersionLookup> versions)
+        : versions_(std::move(versions))
+    {
+    }
+
+    ResolvedArtifact DownloadService::resolve(const std::string &name,
+                                              const std::string &version,
+                                              const std::string &file)
+    {
+        const std::string id = name + "@" + version;
+        const auto rows = versions_->findArtifacts(name, version);
+        if (rows.empty())
+            throw domain::NotFoundError("Version not found: " + id);
+
+        std::vector<const db::VersionArtifact *> matches;
+        for (const auto &row : rows)
+        {
+            if (fileName(row.artifactPath) == file)
+                matches.push_back(&row);
+        }
+
+        if (matches.empty())
+            throw domain::NotFoundError("Artifact not found: " + id + "/" + file);
+        if (matches.size() > 1)
+            throw domain::ConflictError("Ambiguous artifact: " + id + " is published by several owners");
+
+        const auto &row = *matches.front();
+        if (row.yanked)
+            throw domain::GoneError("Version yanked: " + id);
+
+        return ResolvedArtifact{row.artifactPath, row.sha256, row.sizeBytes};
+    }
+} // namespace vix::registry::services
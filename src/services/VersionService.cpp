@@ -0,0 +1,43 @@
+#include <vix/registry/services/VersionService.hpp>
+
+#include <cctype>
+#include <utility>
+
+#include <vix/registry/domain/errors.hpp>
+#include <vix/registry/storage/IPackageStore.hpp>
+
+namespace vix::registry::services
+{
+    using domain::ValidationError;
+
+    VersionService::VersionService(std::shared_ptr<db::PublishQueue> publishQueue)
+        : publishQueue_(std::move(publishQueue))
+    {
+    }
+
+    void VersionService::validate(const domain::Version &v)
+    {
+        if (v.packageId() == 0)
+            throw ValidationError("Missing package id");
+
+        if (v.semver().size() > 64 || !domain::isValidSemver(v.semver()))
+            throw ValidationError("Invalid semver: " + v.semver());
+
+        if (!storage::isValidKey(v.artifactPath()))
+            throw ValidationError("Invalid artifact path: " + v.artifactPath());
+
+        if (v.sha256().size() != 64)
+            throw ValidationError("sha256 must be 64 hex characters");
+        for (char c : v.sha256())
+        {
+            if (!std::isxdigit(static_cast<unsigned char>(c)))
+                throw ValidationError("sha256 must be 64 hex characters");
+        }
+    }
+
+    std::future<db::PublishResult> VersionService::publish(domain::Version version)
+    {
+        validate(version);
+        return publishQueue_->enqueue(std::move(version));
+    }
+} // namespace vix::registry::services
@@ -0,0 +1,284 @@
+#include <vix/registry/storage/LocalFileStorage.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <system_error>
+
+#include <vix/registry/domain/errors.hpp>
+
+namespace vix::registry::storage
+{
+    namespace fs = std::filesystem;
+    using domain::NotFoundError;
+    using domain::StorageError;
+    using domain::ValidationError;
+
+    namespace
+    {
+        constexpr const char *kTempDir = ".tmp";
+        constexpr const char *kQuarantineDir = ".quarantine";
+
+        std::atomic<std::uint64_t> tempCounter{0};
+
+        std::chrono::system_clock::time_point toSystemTime(fs::file_time_type t)
+        {
+            return std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+                t - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
+        }
+    } // namespace
+
+    LocalFileStorage::LocalFileStorage(fs::path root)
+        : root_(std::move(root))
+    {
+        std::error_code ec;
+        fs::create_directories(root_ / kTempDir, ec);
+        if (ec)
+            throw StorageError("Cannot create storage root " + root_.string() + ": " + ec.message());
+    }
+
+    fs::path LocalFileStorage::pathFor(const std::string &key) const
+    {
+        if (!isValidKey(key))
+            throw ValidationError("Invalid storage key: " + key);
+        return root_ / fs::path(key);
+    }
+
+    fs::path LocalFileStorage::tempPath() const
+    {
+        return root_ / kTempDir /
+               ("upload-" + std::to_string(tempCounter.fetch_add(1)) + "-" +
+                std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    }
+
+    void LocalFileStorage::commit(const fs::path &tmp, const std::string &key)
+    {
+        const fs::path dst = pathFor(key);
+
+        std::error_code ec;
+        fs::create_directories(dst.parent_path(), ec);
+        if (!ec)
+            fs::rename(tmp, dst, ec);
+
+        if (ec)
+        {
+            fs::remove(tmp, ec);
+            throw StorageError("Cannot store " + key + ": " + ec.message());
+        }
+    }
+
+    void LocalFileStorage::put(const std::string &key, std::string_view data)
+    {
+        pathFor(key);
+
+        const fs::path tmp = tempPath();
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!out)
+                throw StorageError("Cannot write " + tmp.string());
+        }
+        commit(tmp, key);
+    }
+
+    void LocalFileStorage::putFile(const std::string &key, const fs::path &source)
+    {
+        pathFor(key);
+
+        const fs::path tmp = tempPath();
+        std::error_code ec;
+        fs::copy_file(source, tmp, fs::copy_options::overwrite_existing, ec);
+        if (ec)
+            throw StorageError("Cannot copy " + source.string() + ": " + ec.message());
+        commit(tmp, key);
+    }
+
+    std::string LocalFileStorage::read(const std::string &key,
+                                       std::uint64_t offset,
+                                       std::uint64_t length)
+    {
+        const fs::path p = pathFor(key);
+        std::ifstream in(p, std::ios::binary);
+        if (!in)
+            throw NotFoundError("Artifact not found: " + key);
+
+        in.seekg(0, std::ios::end);
+        const auto total = static_cast<std::uint64_t>(in.tellg());
+        if (offset >= total)
+            return {};
+
+        const std::uint64_t n = std::min(length, total - offset);
+        std::string out(static_cast<std::size_t>(n), '\0');
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(out.data(), static_cast<std::streamsize>(n));
+        if (!in)
+            throw StorageError("Short read on " + key);
+        return out;
+    }
+
+    void LocalFileStorage::getToFile(const std::string &key, const fs::path &target)
+    {
+        const fs::path p = pathFor(key);
+        std::error_code ec;
+        if (!fs::is_regular_file(p, ec))
+            throw NotFoundError("Artifact not found: " + key);
+
+        fs::copy_file(p, target, fs::copy_options::overwrite_existing, ec);
+        if (ec)
+            throw StorageError("Cannot copy " + key + ": " + ec.message());
+    }
+
+    std::optional<std::uint64_t> LocalFileStorage::size(const std::string &key)
+    {
+        std::error_code ec;
+        const auto n = fs::file_size(pathFor(key), ec);
+        if (ec)
+            return std::nullopt;
+        return static_cast<std::uint64_t>(n);
+    }
+
+    void LocalFileStorage::remove(const std::string &key)
+    {
+        std::error_code ec;
+        fs::remove(pathFor(key), ec);
+        if (ec)
+            throw StorageError("Cannot remove " + key + ": " + ec.message());
+    }
+
+    void LocalFileStorage::quarantine(const std::string &key)
+    {
+        const fs::path src = pathFor(key);
+        const fs::path dst = root_ / kQuarantineDir / fs::path(key);
+
+        std::error_code ec;
+        fs::create_directories(dst.parent_path(), ec);
+        if (!ec)
+            fs::rename(src, dst, ec);
+        if (ec)
+            throw StorageError("Cannot quarantine " + key + ": " + ec.message());
+    }
+
+    std::size_t LocalFileStorage::purgeStaleUploads(std::chrono::system_clock::time_point olderThan)
+    {
+        std::size_t removed = 0;
+        std::error_code ec;
+        for (fs::directory_iterator it(root_ / kTempDir, ec), end; !ec && it != end; it.increment(ec))
+        {
+            std::error_code fileEc;
+            const auto mtime = it->last_write_time(fileEc);
+            if (fileEc || toSystemTime(mtime) >= olderThan)
+                continue;
+            if (fs::remove(it->path(), fileEc))
+                ++removed;
+        }
+        if (ec)
+            throw StorageError("Cannot list " + (root_ / kTempDir).string() + ": " + ec.message());
+        return removed;
+    }
+
+    bool LocalFileStorage::collectKeys(const std::string &dir,
+                                       const std::string &prefix,
+                                       const std::string &startAfter,
+                                       std::size_t want,
+                                       std::vector<std::string> &keys) const
+    {
+        for (const auto &entry : sortedEntries(dir))
+        {
+            const std::string path = dir + entry.name;
+            if (entry.isDirectory)
+            {
+                // Every key below `path` starts with it: skip the subtree when
+                // it sorts wholly before the cursor or misses the prefix.
+                if (path < startAfter && startAfter.compare(0, path.size(), path) != 0)
+                    continue;
+                if (path.compare(0, prefix.size(), prefix) != 0 && prefix.compare(0, path.size(), path) != 0)
+                    continue;
+                if (!collectKeys(path, prefix, startAfter, want, keys))
+                    return false;
+                continue;
+            }
+
+            if (path <= startAfter || path.compare(0, prefix.size(), prefix) != 0 || !isValidKey(path))
+                continue;
+            keys.push_back(path);
+            if (keys.size() == want)
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<LocalFileStorage::DirEntry> LocalFileStorage::sortedEntries(const std::string &dir) const
+    {
+        const fs::path path = dir.empty() ? root_ : root_ / fs::path(dir);
+
+        std::vector<DirEntry> entries;
+        std::error_code ec;
+        fs::directory_iterator it(path, fs::directory_options::skip_permission_denied, ec);
+        if (ec == std::errc::no_such_file_or_directory && !dir.empty())
+            return entries; // removed since its parent was read
+        if (ec)
+            throw StorageError("Cannot list " + path.string() + ": " + ec.message());
+
+        for (const fs::directory_iterator end; it != end; it.increment(ec))
+        {
+            if (ec)
+                throw StorageError("Cannot list " + path.string() + ": " + ec.message());
+
+            std::string name = it->path().filename().string();
+            if (name.empty() || name.front() == '.')
+                continue; // .tmp, .quarantine
+
+            std::error_code typeEc;
+            if (fs::is_directory(it->symlink_status(typeEc)))
+                entries.push_back(DirEntry{std::move(name) + "/", true});
+            else if (it->is_regular_file(typeEc))
+                entries.push_back(DirEntry{std::move(name), false});
+        }
+
+        // Directories compare as "name/", so a depth-first walk over sorted
+        // siblings yields keys in plain lexicographic order ("a-b" < "a/x").
+        std::sort(entries.begin(), entries.end(), [](const DirEntry &a, const DirEntry &b)
+                  { return a.name < b.name; });
+        return entries;
+    }
+
+    ObjectPage LocalFileStorage::list(const std::string &prefix,
+                                      const std::string &startAfter,
+                                      std::size_t limit)
+    {
+        // Walks directories in key order from the cursor, so a page reads
+        // the directories on the path to `startAfter` plus the ones it
+        // returns keys from, not the whole tree.
+        if (limit == 0)
+            return {};
+
+        std::vector<std::string> keys;
+        collectKeys("", prefix, startAfter, limit + 1, keys);
+
+        ObjectPage page;
+        if (keys.size() > limit)
+        {
+            keys.pop_back();
+            page.nextStartAfter = keys.back();
+        }
+
+        for (auto &key : keys)
+        {
+            ObjectInfo info{key, 0, {}};
+            const fs::path p = root_ / fs::path(key);
+            std::error_code statEc;
+            info.sizeBytes = static_cast<std::uint64_t>(fs::file_size(p, statEc));
+            if (statEc)
+                continue; // removed since the walk
+            if (const auto mtime = fs::last_write_time(p, statEc); !statEc)
+                info.lastModified = toSystemTime(mtime);
+            page.objects.push_back(std::move(info));
+        }
+        return page;
+    }
+
+    std::optional<std::string> LocalFileStorage::downloadUrl(const std::string &, std::chrono::seconds)
+    {
+        return std::nullopt;
+    }
+} // namespace vix::registry::storage
@@ -0,0 +1,668 @@
+#include <vix/registry/storage/S3Storage.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <initializer_list>
+#include <system_error>
+#include <vector>
+
+#include <vix/registry/domain/errors.hpp>
+#include <vix/registry/storage/Parallel.hpp>
+#include <vix/registry/storage/Sha256.hpp>
+
+namespace vix::registry::storage
+{
+    namespace fs = std::filesystem;
+    using domain::NotFoundError;
+    using domain::StorageError;
+    using domain::ValidationError;
+
+    namespace
+    {
+        constexpr const char *kAlgorithm = "AWS4-HMAC-SHA256";
+        constexpr const char *kUnsignedPayload = "UNSIGNED-PAYLOAD";
+        constexpr std::size_t kMaxListKeys = 1000;
+        constexpr const char *kQuarantinePrefix = ".quarantine/";
+
+        std::string uriEncode(std::string_view s, bool keepSlash)
+        {
+            static constexpr char kHex[] = "0123456789ABCDEF";
+            std::string out;
+            out.reserve(s.size() + 8);
+            for (unsigned char c : s)
+            {
+                if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' ||
+                    (keepSlash && c == '/'))
+                {
+                    out.push_back(static_cast<char>(c));
+                }
+                else
+                {
+                    out.push_back('%');
+                    out.push_back(kHex[c >> 4]);
+                    out.push_back(kHex[c & 0x0f]);
+                }
+            }
+            return out;
+        }
+
+        std::string canonicalQuery(std::vector<std::pair<std::string, std::string>> params)
+        {
+            for (auto &[k, v] : params)
+            {
+                k = uriEncode(k, false);
+                v = uriEncode(v, false);
+            }
+            std::sort(params.begin(), params.end());
+
+            std::string out;
+            for (const auto &[k, v] : params)
+            {
+                if (!out.empty())
+                    out += '&';
+                out += k + '=' + v;
+            }
+            return out;
+        }
+
+        std::string amzDate(std::chrono::system_clock::time_point tp)
+        {
+            const std::time_t t = std::chrono::system_clock::to_time_t(tp);
+            std::tm tm{};
+            ::gmtime_r(&t, &tm);
+            char buf[17];
+            std::strftime(buf, sizeof(buf), "%Y%m%dT%H%M%SZ", &tm);
+            return buf;
+        }
+
+        std::string toString(const Sha256::Digest &d)
+        {
+            return std::string(reinterpret_cast<const char *>(d.data()), d.size());
+        }
+
+        std::string signature(const S3Config &cfg, const std::string &date, const std::string &stringToSign)
+        {
+            const auto kDate = hmacSha256("AWS4" + cfg.secretKey, date.substr(0, 8));
+            const auto kRegion = hmacSha256(toString(kDate), cfg.region);
+            const auto kService = hmacSha256(toString(kRegion), "s3");
+            const auto kSigning = hmacSha256(toString(kService), "aws4_request");
+            return Sha256::toHex(hmacSha256(toString(kSigning), stringToSign));
+        }
+
+        std::string credentialScope(const S3Config &cfg, const std::string &date)
+        {
+            return date.substr(0, 8) + "/" + cfg.region + "/s3/aws4_request";
+        }
+
+        std::string lower(std::string s)
+        {
+            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+            return s;
+        }
+
+        std::optional<std::string> xmlTag(const std::string &xml, const std::string &tag, std::size_t from = 0)
+        {
+            const std::string open = "<" + tag + ">";
+            const std::string close = "</" + tag + ">";
+            const auto b = xml.find(open, from);
+            if (b == std::string::npos)
+                return std::nullopt;
+            const auto e = xml.find(close, b + open.size());
+            if (e == std::string::npos)
+                return std::nullopt;
+            return xml.substr(b + open.size(), e - b - open.size());
+        }
+
+        std::string xmlUnescape(std::string s)
+        {
+            static const std::pair<std::string, char> kEntities[] = {
+                {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}};
+
+            std::string out;
+            out.reserve(s.size());
+            for (std::size_t i = 0; i < s.size();)
+            {
+                bool replaced = false;
+                if (s[i] == '&')
+                {
+                    for (const auto &[entity, c] : kEntities)
+                    {
+                        if (s.compare(i, entity.size(), entity) == 0)
+                        {
+                            out.push_back(c);
+                            i += entity.size();
+                            replaced = true;
+                            break;
+                        }
+                    }
+                }
+                if (!replaced)
+                    out.push_back(s[i++]);
+            }
+            return out;
+        }
+
+        // "2009-10-12T17:50:30.000Z" as returned in S3 listings; nullopt if
+        // missing or malformed.
+        std::optional<std::chrono::system_clock::time_point> parseIsoTime(const std::string &s)
+        {
+            std::tm tm{};
+            if (std::sscanf(s.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d",
+                            &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+                            &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6)
+                return std::nullopt;
+            tm.tm_year -= 1900;
+            tm.tm_mon -= 1;
+            return std::chrono::system_clock::from_time_t(::timegm(&tm));
+        }
+
+        void expectStatus(const S3Response &res, std::initializer_list<int> ok, const std::string &what)
+        {
+            if (std::find(ok.begin(), ok.end(), res.status) != ok.end())
+                return;
+            throw StorageError("S3 " + what + " failed with HTTP " + std::to_string(res.status) +
+                               " (" + xmlTag(res.body, "Code").value_or("no error code") + ")");
+        }
+
+        void checkKey(const std::string &key)
+        {
+            if (!isValidKey(key))
+                throw ValidationError("Invalid storage key: " + key);
+        }
+    } // namespace
+
+    S3Storage::S3Storage(S3Config config, std::shared_ptr<IS3Transport> transport)
+        : config_(std::move(config)), transport_(std::move(transport))
+    {
+        if (config_.bucket.empty())
+            throw ValidationError("S3 bucket is not configured");
+        if (config_.partSize < 5ull * 1024 * 1024)
+            config_.partSize = 5ull * 1024 * 1024; // S3 minimum for non-final parts
+        if (config_.multipartThreshold < config_.partSize)
+            config_.multipartThreshold = config_.partSize;
+        if (config_.parallelism == 0)
+            config_.parallelism = 1;
+        parallelism_.store(config_.parallelism);
+
+        if (!transport_)
+        {
+            HttpTransportConfig http{};
+            http.host = config_.pathStyle ? config_.endpoint : config_.bucket + "." + config_.endpoint;
+            http.port = config_.port;
+            http.maxConnections = std::max(config_.maxConnections, config_.parallelism);
+            transport_ = std::make_shared<PooledHttpTransport>(std::move(http));
+        }
+    }
+
+    void S3Storage::setConcurrency(std::size_t parallelism, std::size_t maxConnections)
+    {
+        parallelism_.store(std::max<std::size_t>(1, parallelism), std::memory_order_relaxed);
+        if (auto *pooled = dynamic_cast<PooledHttpTransport *>(transport_.get()))
+            pooled->setMaxConnections(std::max(maxConnections, parallelism));
+    }
+
+    std::string S3Storage::hostHeader() const
+    {
+        std::string host = config_.pathStyle ? config_.endpoint : config_.bucket + "." + config_.endpoint;
+        if (config_.port != 80 && config_.port != 443)
+            host += ":" + std::to_string(config_.port);
+        return host;
+    }
+
+    // The host is part of the SigV4 signature, so presigned URLs must be
+    // signed for the name clients will actually send.
+    std::string S3Storage::publicHost() const
+    {
+        if (config_.publicEndpoint.empty())
+            return hostHeader();
+
+        std::string host = config_.pathStyle ? config_.publicEndpoint
+                                             : config_.bucket + "." + config_.publicEndpoint;
+        if (config_.publicPort != 0)
+            host += ":" + std::to_string(config_.publicPort);
+        return host;
+    }
+
+    std::string S3Storage::publicScheme() const
+    {
+        if (!config_.publicScheme.empty())
+            return config_.publicScheme;
+        if (!config_.publicEndpoint.empty() || config_.port == 443)
+            return "https";
+        return "http";
+    }
+
+    std::string S3Storage::objectPath(const std::string &key) const
+    {
+        if (config_.pathStyle)
+            return "/" + uriEncode(config_.bucket, false) + "/" + uriEncode(key, true);
+        return "/" + uriEncode(key, true);
+    }
+
+    std::string S3Storage::bucketPath() const
+    {
+        return config_.pathStyle ? "/" + uriEncode(config_.bucket, false) : "/";
+    }
+
+    S3Request S3Storage::makeRequest(const std::string &method, const std::string &key) const
+    {
+        S3Request req;
+        req.method = method;
+        req.path = objectPath(key);
+        return req;
+    }
+
+    S3Response S3Storage::send(S3Request req, const std::string &payloadHash) const
+    {
+        const std::string date = amzDate(std::chrono::system_clock::now());
+
+        req.headers.emplace_back("host", hostHeader());
+        req.headers.emplace_back("x-amz-content-sha256", payloadHash);
+        req.headers.emplace_back("x-amz-date", date);
+
+        std::vector<std::pair<std::string, std::string>> canonical;
+        canonical.reserve(req.headers.size());
+        for (const auto &[k, v] : req.headers)
+            canonical.emplace_back(lower(k), v);
+        std::sort(canonical.begin(), canonical.end());
+
+        std::string canonicalHeaders;
+        std::string signedHeaders;
+        for (const auto &[k, v] : canonical)
+        {
+            canonicalHeaders += k + ":" + v + "\n";
+            if (!signedHeaders.empty())
+                signedHeaders += ';';
+            signedHeaders += k;
+        }
+
+        const std::string canonicalRequest = req.method + "\n" + req.path + "\n" + req.query + "\n" +
+                                             canonicalHeaders + "\n" + signedHeaders + "\n" + payloadHash;
+        const std::string scope = credentialScope(config_, date);
+        const std::string stringToSign = std::string(kAlgorithm) + "\n" + date + "\n" + scope + "\n" +
+                                         Sha256::hex(canonicalRequest);
+
+        req.headers.emplace_back("Authorization",
+                                 std::string(kAlgorithm) + " Credential=" + config_.accessKey + "/" + scope +
+                                     ", SignedHeaders=" + signedHeaders +
+                                     ", Signature=" + signature(config_, date, stringToSign));
+
+        return transport_->send(req);
+    }
+
+    void S3Storage::put(const std::string &key, std::string_view data)
+    {
+        checkKey(key);
+
+        if (data.size() <= config_.multipartThreshold)
+        {
+            auto req = makeRequest("PUT", key);
+            req.body.assign(data);
+            const std::string hash = Sha256::hex(req.body);
+            expectStatus(send(std::move(req), hash), {200}, "PUT " + key);
+            return;
+        }
+
+        putMultipart(key, data.size(), [&](std::uint64_t offset, std::uint64_t len)
+                     { return std::string(data.substr(offset, len)); });
+    }
+
+    void S3Storage::putFile(const std::string &key, const fs::path &source)
+    {
+        checkKey(key);
+
+        std::error_code ec;
+        const auto total = static_cast<std::uint64_t>(fs::file_size(source, ec));
+        if (ec)
+            throw StorageError("Cannot stat " + source.string() + ": " + ec.message());
+
+        auto readPart = [&](std::uint64_t offset, std::uint64_t len)
+        {
+            std::ifstream in(source, std::ios::binary);
+            std::string buf(static_cast<std::size_t>(len), '\0');
+            in.seekg(static_cast<std::streamoff>(offset));
+            in.read(buf.data(), static_cast<std::streamsize>(len));
+            if (!in)
+                throw StorageError("Short read on " + source.string());
+            return buf;
+        };
+
+        if (total <= config_.multipartThreshold)
+        {
+            auto req = makeRequest("PUT", key);
+            req.body = readPart(0, total);
+            const std::string hash = Sha256::hex(req.body);
+            expectStatus(send(std::move(req), hash), {200}, "PUT " + key);
+            return;
+        }
+
+        putMultipart(key, total, readPart);
+    }
+
+    template <typename ReadPart>
+    void S3Storage::putMultipart(const std::string &key, std::uint64_t total, ReadPart readPart)
+    {
+        const std::string emptyHash = Sha256::hex("");
+
+        auto init = makeRequest("POST", key);
+        init.query = "uploads=";
+        const auto initRes = send(std::move(init), emptyHash);
+        expectStatus(initRes, {200}, "CreateMultipartUpload " + key);
+
+        const auto uploadId = xmlTag(initRes.body, "UploadId");
+        if (!uploadId)
+            throw StorageError("S3 CreateMultipartUpload returned no UploadId for " + key);
+
+        const std::size_t parts = static_cast<std::size_t>((total + config_.partSize - 1) / config_.partSize);
+        std::vector<std::string> etags(parts);
+
+        try
+        {
+            runParallel(parts, parallelism(), [&](std::size_t i)
+                        {
+                const std::uint64_t offset = i * config_.partSize;
+                const std::uint64_t len = std::min(config_.partSize, total - offset);
+
+                auto req = makeRequest("PUT", key);
+                req.query = canonicalQuery({{"partNumber", std::to_string(i + 1)}, {"uploadId", *uploadId}});
+                req.body = readPart(offset, len);
+                const std::string hash = Sha256::hex(req.body);
+
+                const auto res = send(std::move(req), hash);
+                expectStatus(res, {200}, "UploadPart " + key);
+
+                const auto etag = res.header("ETag");
+                if (!etag)
+                    throw StorageError("S3 UploadPart returned no ETag for " + key);
+                etags[i] = *etag; });
+
+            std::string body = "<CompleteMultipartUpload>";
+            for (std::size_t i = 0; i < parts; ++i)
+            {
+                body += "<Part><PartNumber>" + std::to_string(i + 1) + "</PartNumber><ETag>" +
+                        etags[i] + "</ETag></Part>";
+            }
+            body += "</CompleteMultipartUpload>";
+
+            auto complete = makeRequest("POST", key);
+            complete.query = canonicalQuery({{"uploadId", *uploadId}});
+            complete.body = std::move(body);
+            const std::string hash = Sha256::hex(complete.body);
+
+            // S3 may report a failed completion as 200 with an <Error> body.
+            const auto res = send(std::move(complete), hash);
+            expectStatus(res, {200}, "CompleteMultipartUpload " + key);
+            if (res.body.find("<Error>") != std::string::npos)
+                throw StorageError("S3 CompleteMultipartUpload failed for " + key + " (" +
+                                   xmlTag(res.body, "Code").value_or("no error code") + ")");
+        }
+        catch (...)
+        {
+            auto abort = makeRequest("DELETE", key);
+            abort.query = canonicalQuery({{"uploadId", *uploadId}});
+            try
+            {
+                send(std::move(abort), emptyHash);
+            }
+            catch (...)
+            {
+                // The bucket lifecycle rule reaps uploads we fail to abort.
+            }
+            throw;
+        }
+    }
+
+    std::string S3Storage::read(const std::string &key, std::uint64_t offset, std::uint64_t length)
+    {
+        checkKey(key);
+        if (length == 0)
+            return {};
+
+        auto req = makeRequest("GET", key);
+        req.headers.emplace_back("range", "bytes=" + std::to_string(offset) + "-" +
+                                              std::to_string(offset + length - 1));
+
+        auto res = send(std::move(req), Sha256::hex(""));
+        if (res.status == 404)
+            throw NotFoundError("Artifact not found: " + key);
+        if (res.status == 416)
+            return {};
+        expectStatus(res, {200, 206}, "GET " + key);
+
+        if (res.status == 200)
+        {
+            // Range ignored by the server: slice the full object ourselves.
+            if (offset >= res.body.size())
+                return {};
+            return res.body.substr(static_cast<std::size_t>(offset), static_cast<std::size_t>(length));
+        }
+        return std::move(res.body);
+    }
+
+    void S3Storage::getToFile(const std::string &key, const fs::path &target)
+    {
+        const auto total = size(key);
+        if (!total)
+            throw NotFoundError("Artifact not found: " + key);
+
+        fs::path tmp = target;
+        tmp += ".part";
+        {
+            std::ofstream create(tmp, std::ios::binary | std::ios::trunc);
+            if (!create)
+                throw StorageError("Cannot create " + tmp.string());
+        }
+
+        std::error_code ec;
+        fs::resize_file(tmp, *total, ec);
+        if (ec)
+            throw StorageError("Cannot allocate " + tmp.string() + ": " + ec.message());
+
+        const std::size_t parts = static_cast<std::size_t>((*total + config_.partSize - 1) / config_.partSize);
+        try
+        {
+            runParallel(parts, parallelism(), [&](std::size_t i)
+                        {
+                const std::uint64_t offset = i * config_.partSize;
+                const std::uint64_t len = std::min(config_.partSize, *total - offset);
+
+                const std::string chunk = read(key, offset, len);
+                if (chunk.size() != len)
+                    throw StorageError("Short ranged GET on " + key);
+
+                std::fstream out(tmp, std::ios::in | std::ios::out | std::ios::binary);
+                out.seekp(static_cast<std::streamoff>(offset));
+                out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+                if (!out)
+                    throw StorageError("Cannot write " + tmp.string()); });
+
+            fs::rename(tmp, target, ec);
+            if (ec)
+                throw StorageError("Cannot move " + tmp.string() + ": " + ec.message());
+        }
+        catch (...)
+        {
+            fs::remove(tmp, ec);
+            throw;
+        }
+    }
+
+    std::optional<std::uint64_t> S3Storage::size(const std::string &key)
+    {
+        checkKey(key);
+
+        const auto res = send(makeRequest("HEAD", key), Sha256::hex(""));
+        if (res.status == 404)
+            return std::nullopt;
+        expectStatus(res, {200}, "HEAD " + key);
+
+        const auto len = res.header("Content-Length");
+        if (!len)
+            throw StorageError("S3 HEAD returned no Content-Length for " + key);
+        return std::strtoull(len->c_str(), nullptr, 10);
+    }
+
+    void S3Storage::remove(const std::string &key)
+    {
+        checkKey(key);
+        expectStatus(send(makeRequest("DELETE", key), Sha256::hex("")), {200, 204, 404}, "DELETE " + key);
+    }
+
+    ObjectPage S3Storage::list(const std::string &prefix, const std::string &startAfter, std::size_t limit)
+    {
+        if (limit == 0)
+            return {};
+
+        std::vector<std::pair<std::string, std::string>> params{
+            {"list-type", "2"},
+            {"max-keys", std::to_string(std::min(limit, kMaxListKeys))}};
+        if (!prefix.empty())
+            params.emplace_back("prefix", prefix);
+        if (!startAfter.empty())
+            params.emplace_back("start-after", startAfter);
+
+        S3Request req;
+        req.method = "GET";
+        req.path = bucketPath();
+        req.query = canonicalQuery(std::move(params));
+
+        const auto res = send(std::move(req), Sha256::hex(""));
+        expectStatus(res, {200}, "ListObjectsV2");
+
+        // Reserved keys (quarantine, foreign junk) are skipped, but the
+        // cursor still advances past them.
+        ObjectPage page;
+        std::string lastKey;
+        std::size_t pos = 0;
+        while ((pos = res.body.find("<Contents>", pos)) != std::string::npos)
+        {
+            const auto end = res.body.find("</Contents>", pos);
+            const std::string entry = res.body.substr(pos, end == std::string::npos ? end : end - pos);
+            pos = (end == std::string::npos) ? res.body.size() : end;
+
+            ObjectInfo info;
+            info.key = xmlUnescape(xmlTag(entry, "Key").value_or(""));
+            info.sizeBytes = std::strtoull(xmlTag(entry, "Size").value_or("0").c_str(), nullptr, 10);
+            info.lastModified = parseIsoTime(xmlTag(entry, "LastModified").value_or(""));
+            if (info.key.empty())
+                continue;
+            lastKey = info.key;
+            if (isValidKey(info.key))
+                page.objects.push_back(std::move(info));
+        }
+
+        if (xmlTag(res.body, "IsTruncated").value_or("false") == "true" && !lastKey.empty())
+            page.nextStartAfter = lastKey;
+        return page;
+    }
+
+    void S3Storage::quarantine(const std::string &key)
+    {
+        checkKey(key);
+
+        // Server-side copy, so the bytes never leave the store. CopyObject
+        // is limited to 5 GiB; larger blobs surface as a StorageError.
+        auto copy = makeRequest("PUT", kQuarantinePrefix + key);
+        copy.headers.emplace_back("x-amz-copy-source",
+                                  "/" + uriEncode(config_.bucket, false) + "/" + uriEncode(key, true));
+        const auto res = send(std::move(copy), Sha256::hex(""));
+        expectStatus(res, {200}, "CopyObject " + key);
+        if (res.body.find("<Error>") != std::string::npos)
+            throw StorageError("S3 CopyObject failed for " + key + " (" +
+                               xmlTag(res.body, "Code").value_or("no error code") + ")");
+
+        remove(key);
+    }
+
+    std::size_t S3Storage::purgeStaleUploads(std::chrono::system_clock::time_point olderThan)
+    {
+        const std::string emptyHash = Sha256::hex("");
+        std::size_t aborted = 0;
+        std::string keyMarker;
+        std::string uploadIdMarker;
+
+        for (;;)
+        {
+            std::vector<std::pair<std::string, std::string>> params{{"uploads", ""}};
+            if (!keyMarker.empty())
+                params.emplace_back("key-marker", keyMarker);
+            if (!uploadIdMarker.empty())
+                params.emplace_back("upload-id-marker", uploadIdMarker);
+
+            S3Request req;
+            req.method = "GET";
+            req.path = bucketPath();
+            req.query = canonicalQuery(std::move(params));
+
+            const auto res = send(std::move(req), emptyHash);
+            expectStatus(res, {200}, "ListMultipartUploads");
+
+            std::size_t pos = 0;
+            while ((pos = res.body.find("<Upload>", pos)) != std::string::npos)
+            {
+                const auto end = res.body.find("</Upload>", pos);
+                const std::string entry = res.body.substr(pos, end == std::string::npos ? end : end - pos);
+                pos = (end == std::string::npos) ? res.body.size() : end;
+
+                // Uploads of unknown age are left alone.
+                const auto key = xmlTag(entry, "Key");
+                const auto uploadId = xmlTag(entry, "UploadId");
+                const auto initiated = parseIsoTime(xmlTag(entry, "Initiated").value_or(""));
+                if (!key || !uploadId || !initiated || *initiated >= olderThan)
+                    continue;
+
+                auto abort = makeRequest("DELETE", xmlUnescape(*key));
+                abort.query = canonicalQuery({{"uploadId", xmlUnescape(*uploadId)}});
+                expectStatus(send(std::move(abort), emptyHash), {200, 204, 404}, "AbortMultipartUpload " + *key);
+                ++aborted;
+            }
+
+            if (xmlTag(res.body, "IsTruncated").value_or("false") != "true")
+                return aborted;
+            keyMarker = xmlUnescape(xmlTag(res.body, "NextKeyMarker").value_or(""));
+            uploadIdMarker = xmlUnescape(xmlTag(res.body, "NextUploadIdMarker").value_or(""));
+            if (keyMarker.empty())
+                return aborted;
+        }
+    }
+
+    std::optional<std::string> S3Storage::downloadUrl(const std::string &key, std::chrono::seconds ttl)
+    {
+        return presign(key, ttl, std::chrono::system_clock::now());
+    }
+
+    std::string S3Storage::presign(const std::string &key,
+                                   std::chrono::seconds ttl,
+                                   std::chrono::system_clock::time_point now) const
+    {
+        checkKey(key);
+
+        // SigV4 caps presigned URLs at 7 days.
+        const auto expires = std::clamp<std::int64_t>(ttl.count(), 1, 7 * 24 * 3600);
+        const std::string date = amzDate(now);
+        const std::string scope = credentialScope(config_, date);
+        const std::string host = publicHost();
+        const std::string path = objectPath(key);
+
+        const std::string query = canonicalQuery({
+            {"X-Amz-Algorithm", kAlgorithm},
+            {"X-Amz-Credential", config_.accessKey + "/" + scope},
+            {"X-Amz-Date", date},
+            {"X-Amz-Expires", std::to_string(expires)},
+            {"X-Amz-SignedHeaders", "host"},
+        });
+
+        const std::string canonicalRequest = "GET\n" + path + "\n" + query + "\nhost:" + host +
+                                             "\n\nhost\n" + kUnsignedPayload;
+        const std::string stringToSign = std::string(kAlgorithm) + "\n" + date + "\n" + scope + "\n" +
+                                         Sha256::hex(canonicalRequest);
+
+        return publicScheme() + "://" + host + path + "?" + query +
+               "&X-Amz-Signature=" + signature(config_, date, stringToSign);
+    }
+} // namespace vix::registry::storage
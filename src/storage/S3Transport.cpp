@@ -0,0 +1,406 @@
+#include <vix/registry/storage/S3Transport.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <vix/registry/domain/errors.hpp>
+
+namespace vix::registry::storage
+{
+    using domain::StorageError;
+
+    namespace
+    {
+        bool iequals(const std::string &a, const std::string &b)
+        {
+            return a.size() == b.size() &&
+                   std::equal(a.begin(), a.end(), b.begin(), [](char x, char y)
+                              { return std::tolower(static_cast<unsigned char>(x)) ==
+                                       std::tolower(static_cast<unsigned char>(y)); });
+        }
+
+        std::string trim(const std::string &s)
+        {
+            const auto b = s.find_first_not_of(" \t");
+            if (b == std::string::npos)
+                return {};
+            const auto e = s.find_last_not_of(" \t\r");
+            return s.substr(b, e - b + 1);
+        }
+
+        bool isIdempotent(const std::string &method)
+        {
+            return method == "GET" || method == "HEAD" || method == "PUT" || method == "DELETE";
+        }
+
+        bool hasHeader(const std::vector<std::pair<std::string, std::string>> &headers,
+                       const std::string &name)
+        {
+            return std::any_of(headers.begin(), headers.end(), [&](const auto &h)
+                               { return iequals(h.first, name); });
+        }
+    } // namespace
+
+    std::optional<std::string> S3Response::header(const std::string &name) const
+    {
+        for (const auto &[k, v] : headers)
+        {
+            if (iequals(k, name))
+                return v;
+        }
+        return std::nullopt;
+    }
+
+    class PooledHttpTransport::Connection
+    {
+    public:
+        Connection(const std::string &host, std::uint16_t port, std::chrono::milliseconds timeout)
+        {
+            addrinfo hints{};
+            hints.ai_family = AF_UNSPEC;
+            hints.ai_socktype = SOCK_STREAM;
+
+            addrinfo *res = nullptr;
+            const std::string service = std::to_string(port);
+            if (const int rc = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &res); rc != 0)
+                throw StorageError("Cannot resolve " + host + ": " + ::gai_strerror(rc));
+
+            timeval tv{};
+            tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+            tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+
+            for (addrinfo *ai = res; ai != nullptr; ai = ai->ai_next)
+            {
+                const int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+                if (fd < 0)
+                    continue;
+
+                ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+                ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+                const int one = 1;
+                ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+                if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+                {
+                    fd_ = fd;
+                    break;
+                }
+                ::close(fd);
+            }
+            ::freeaddrinfo(res);
+
+            if (fd_ < 0)
+                throw StorageError("Cannot connect to " + host + ":" + service);
+        }
+
+        ~Connection()
+        {
+            if (fd_ >= 0)
+                ::close(fd_);
+        }
+
+        Connection(const Connection &) = delete;
+        Connection &operator=(const Connection &) = delete;
+
+        // Since the last resetCounters(), i.e. for the current exchange.
+        std::size_t bytesSent() const noexcept { return bytesSent_; }
+        std::size_t bytesReceived() const noexcept { return bytesReceived_; }
+        void resetCounters() noexcept { bytesSent_ = bytesReceived_ = 0; }
+
+        void writeAll(const char *data, std::size_t len)
+        {
+            while (len > 0)
+            {
+                const ssize_t n = ::send(fd_, data, len, MSG_NOSIGNAL);
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    throw StorageError(std::string("Socket write failed: ") + std::strerror(errno));
+                }
+                bytesSent_ += static_cast<std::size_t>(n);
+                data += n;
+                len -= static_cast<std::size_t>(n);
+            }
+        }
+
+        std::string readLine()
+        {
+            for (;;)
+            {
+                const auto eol = buf_.find("\r\n", pos_);
+                if (eol != std::string::npos)
+                {
+                    std::string line = buf_.substr(pos_, eol - pos_);
+                    pos_ = eol + 2;
+                    return line;
+                }
+                if (!fill())
+                    throw StorageError("Connection closed while reading headers");
+            }
+        }
+
+        void readExact(std::string &out, std::size_t n)
+        {
+            out.reserve(out.size() + n);
+            while (n > 0)
+            {
+                if (pos_ == buf_.size() && !fill())
+                    throw StorageError("Connection closed while reading body");
+                const std::size_t take = std::min(n, buf_.size() - pos_);
+                out.append(buf_, pos_, take);
+                pos_ += take;
+                n -= take;
+            }
+        }
+
+        void readToEof(std::string &out)
+        {
+            for (;;)
+            {
+                out.append(buf_, pos_, std::string::npos);
+                pos_ = buf_.size();
+                if (!fill())
+                    return;
+            }
+        }
+
+    private:
+        bool fill()
+        {
+            if (pos_ == buf_.size())
+            {
+                buf_.clear();
+                pos_ = 0;
+            }
+
+            char chunk[64 * 1024];
+            for (;;)
+            {
+                const ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+                if (n > 0)
+                {
+                    bytesReceived_ += static_cast<std::size_t>(n);
+                    buf_.append(chunk, static_cast<std::size_t>(n));
+                    return true;
+                }
+                if (n == 0)
+                    return false;
+                if (errno == EINTR)
+                    continue;
+                throw StorageError(std::string("Socket read failed: ") + std::strerror(errno));
+            }
+        }
+
+        int fd_{-1};
+        std::string buf_;
+        std::size_t pos_{0};
+        std::size_t bytesSent_{0};
+        std::size_t bytesReceived_{0};
+    };
+
+    PooledHttpTransport::PooledHttpTransport(HttpTransportConfig config)
+        : config_(std::move(config))
+    {
+        if (config_.maxConnections == 0)
+            config_.maxConnections = 1;
+    }
+
+    PooledHttpTransport::~PooledHttpTransport() = default;
+
+    std::size_t PooledHttpTransport::idleConnections() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_.size();
+    }
+
+    void PooledHttpTransport::setMaxConnections(std::size_t maxConnections)
+    {
+        std::vector<std::unique_ptr<Connection>> surplus;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_.maxConnections = std::max<std::size_t>(1, maxConnections);
+            while (open_ > config_.maxConnections && !idle_.empty())
+            {
+                surplus.push_back(std::move(idle_.back()));
+                idle_.pop_back();
+                --open_;
+            }
+        }
+        available_.notify_all();
+    }
+
+    std::unique_ptr<PooledHttpTransport::Connection> PooledHttpTransport::acquire(bool &reused)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            available_.wait(lock, [this]
+                            { return !idle_.empty() || open_ < config_.maxConnections; });
+
+            if (!idle_.empty())
+            {
+                auto conn = std::move(idle_.back());
+                idle_.pop_back();
+                reused = true;
+                return conn;
+            }
+            ++open_;
+        }
+
+        reused = false;
+        try
+        {
+            return std::make_unique<Connection>(config_.host, config_.port, config_.ioTimeout);
+        }
+        catch (...)
+        {
+            release(nullptr, false);
+            throw;
+        }
+    }
+
+    void PooledHttpTransport::release(std::unique_ptr<Connection> conn, bool keepAlive)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (conn && keepAlive && open_ <= config_.maxConnections)
+                idle_.push_back(std::move(conn));
+            else
+                --open_;
+        }
+        available_.notify_one();
+    }
+
+    S3Response PooledHttpTransport::exchange(Connection &conn, const S3Request &req, bool &keepAlive)
+    {
+        std::string head;
+        head.reserve(256);
+        head += req.method;
+        head += ' ';
+        head += req.path;
+        if (!req.query.empty())
+        {
+            head += '?';
+            head += req.query;
+        }
+        head += " HTTP/1.1\r\n";
+
+        if (!hasHeader(req.headers, "host"))
+        {
+            head += "Host: " + config_.host;
+            if (config_.port != 80)
+                head += ":" + std::to_string(config_.port);
+            head += "\r\n";
+        }
+        for (const auto &[k, v] : req.headers)
+            head += k + ": " + v + "\r\n";
+        if (!req.body.empty() || req.method == "PUT" || req.method == "POST")
+            head += "Content-Length: " + std::to_string(req.body.size()) + "\r\n";
+        head += "Connection: keep-alive\r\n\r\n";
+
+        conn.writeAll(head.data(), head.size());
+        if (!req.body.empty())
+            conn.writeAll(req.body.data(), req.body.size());
+
+        S3Response res;
+        const std::string statusLine = conn.readLine();
+        if (statusLine.size() < 12 || statusLine.compare(0, 5, "HTTP/") != 0)
+            throw StorageError("Malformed HTTP status line: " + statusLine);
+        res.status = std::atoi(statusLine.c_str() + 9);
+        keepAlive = statusLine.compare(0, 8, "HTTP/1.0") != 0;
+
+        for (;;)
+        {
+            const std::string line = conn.readLine();
+            if (line.empty())
+                break;
+            const auto colon = line.find(':');
+            if (colon == std::string::npos)
+                continue;
+            res.headers.emplace_back(line.substr(0, colon), trim(line.substr(colon + 1)));
+        }
+
+        if (const auto c = res.header("Connection"); c && iequals(*c, "close"))
+            keepAlive = false;
+
+        const bool noBody = req.method == "HEAD" || res.status == 204 || res.status == 304 ||
+                            (res.status >= 100 && res.status < 200);
+        if (noBody)
+            return res;
+
+        if (const auto te = res.header("Transfer-Encoding"); te && iequals(*te, "chunked"))
+        {
+            for (;;)
+            {
+                const std::size_t n = std::strtoul(conn.readLine().c_str(), nullptr, 16);
+                if (n == 0)
+                {
+                    while (!conn.readLine().empty())
+                    {
+                    }
+                    break;
+                }
+                conn.readExact(res.body, n);
+                conn.readLine();
+            }
+        }
+        else if (const auto cl = res.header("Content-Length"))
+        {
+            conn.readExact(res.body, static_cast<std::size_t>(std::strtoull(cl->c_str(), nullptr, 10)));
+        }
+        else
+        {
+            conn.readToEof(res.body);
+            keepAlive = false;
+        }
+
+        return res;
+    }
+
+    S3Response PooledHttpTransport::send(const S3Request &req)
+    {
+        for (int attempt = 0;; ++attempt)
+        {
+            bool reused = false;
+            auto conn = acquire(reused);
+            conn->resetCounters();
+
+            try
+            {
+                bool keepAlive = true;
+                S3Response res = exchange(*conn, req, keepAlive);
+                release(std::move(conn), keepAlive);
+                return res;
+            }
+            catch (const StorageError &)
+            {
+                // A pooled connection the server closed while idle fails
+                // before any reply. Replay only if the server cannot have
+                // acted on the request: nothing came back, and the method is
+                // idempotent or none of it went out (a second POST
+                // CreateMultipartUpload would start a second upload).
+                const bool replay = reused && attempt == 0 && conn->bytesReceived() == 0 &&
+                                    (isIdempotent(req.method) || conn->bytesSent() == 0);
+                release(nullptr, false);
+                if (!replay)
+                    throw;
+            }
+            catch (...)
+            {
+                // e.g. std::length_error on a bogus Content-Length: the
+                // slot must still be returned or acquire() starves.
+                release(nullptr, false);
+                throw;
+            }
+        }
+    }
+} // namespace vix::registry::storage
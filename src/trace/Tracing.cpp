@@ -0,0 +1,247 @@
+#include <vix/registry/trace/Tracing.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <thread>
+#include <utility>
+
+namespace vix::registry::trace
+{
+    namespace
+    {
+        thread_local RequestTrace *tlsCurrent = nullptr;
+        thread_local std::uint64_t tlsSeq = 0;
+
+        std::atomic<bool> cfgEnabled{true};
+        std::atomic<bool> cfgServerTiming{true};
+        std::atomic<std::uint32_t> cfgSampleEvery{100};
+        std::atomic<std::int64_t> cfgSlowMs{500};
+
+        void appendMs(std::string &out, std::uint64_t ns)
+        {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.3f", static_cast<double>(ns) / 1e6);
+            out += buf;
+        }
+
+        void appendJsonString(std::string &out, std::string_view s)
+        {
+            out += '"';
+            for (char c : s)
+            {
+                switch (c)
+                {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                        out += buf;
+                    }
+                    else
+                    {
+                        out += c;
+                    }
+                }
+            }
+            out += '"';
+        }
+    } // namespace
+
+    const char *stageName(Stage stage) noexcept
+    {
+        switch (stage)
+        {
+        case Stage::Auth:
+            return "auth";
+        case Stage::Cache:
+            return "cache";
+        case Stage::DbAcquire:
+            return "db-acquire";
+        case Stage::DbQuery:
+            return "db";
+        case Stage::Storage:
+            return "storage";
+        case Stage::Serialize:
+            return "serialize";
+        }
+        return "unknown";
+    }
+
+    SpanRing &SpanRing::local() noexcept
+    {
+        thread_local SpanRing ring;
+        return ring;
+    }
+
+    TraceConfig traceConfig()
+    {
+        TraceConfig cfg;
+        cfg.enabled = cfgEnabled.load(std::memory_order_relaxed);
+        cfg.serverTiming = cfgServerTiming.load(std::memory_order_relaxed);
+        cfg.sampleEvery = cfgSampleEvery.load(std::memory_order_relaxed);
+        cfg.slowThreshold = std::chrono::milliseconds(cfgSlowMs.load(std::memory_order_relaxed));
+        return cfg;
+    }
+
+    void setTraceConfig(const TraceConfig &config)
+    {
+        cfgEnabled.store(config.enabled, std::memory_order_relaxed);
+        cfgServerTiming.store(config.serverTiming, std::memory_order_relaxed);
+        cfgSampleEvery.store(config.sampleEvery, std::memory_order_relaxed);
+        cfgSlowMs.store(config.slowThreshold.count(), std::memory_order_relaxed);
+    }
+
+    std::uint64_t RequestTrace::nowNs() noexcept
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+    }
+
+    RequestTrace::RequestTrace(std::string method, std::string path, std::string requestId)
+        : method_(std::move(method)),
+          path_(std::move(path)),
+          requestId_(requestId.empty() ? generateRequestId() : std::move(requestId)),
+          seq_(++tlsSeq),
+          startNs_(nowNs()),
+          ringStart_(SpanRing::local().head()),
+          previous_(tlsCurrent)
+    {
+        tlsCurrent = this;
+    }
+
+    RequestTrace::~RequestTrace()
+    {
+        tlsCurrent = previous_;
+    }
+
+    RequestTrace *RequestTrace::current() noexcept
+    {
+        return tlsCurrent;
+    }
+
+    void RequestTrace::record(Stage stage, std::uint64_t startNs, std::uint64_t durNs) noexcept
+    {
+        const auto i = static_cast<std::size_t>(stage);
+        stageNs_[i] += durNs;
+        ++stageCount_[i];
+        SpanRing::local().push(SpanRecord{seq_, startNs, durNs, stage});
+    }
+
+    std::string RequestTrace::serverTiming() const
+    {
+        std::string out;
+        out.reserve(160);
+        for (std::size_t i = 0; i < kStageCount; ++i)
+        {
+            if (stageCount_[i] == 0)
+                continue;
+            out += stageName(static_cast<Stage>(i));
+            out += ";dur=";
+            appendMs(out, stageNs_[i]);
+            out += ", ";
+        }
+        out += "total;dur=";
+        appendMs(out, elapsedNs());
+        return out;
+    }
+
+    std::string RequestTrace::toJson() const
+    {
+        const auto wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::system_clock::now().time_since_epoch())
+                                .count();
+
+        std::string out;
+        out.reserve(256);
+        out += "{\"ts\":" + std::to_string(wallMs);
+        out += ",\"request_id\":";
+        appendJsonString(out, requestId_);
+        out += ",\"method\":";
+        appendJsonString(out, method_);
+        out += ",\"path\":";
+        appendJsonString(out, path_);
+        out += ",\"status\":" + std::to_string(status_);
+        out += ",\"latency_ms\":";
+        appendMs(out, elapsedNs());
+
+        out += ",\"spans\":[";
+        bool first = true;
+        SpanRing::local().forEachSince(ringStart_, [&](const SpanRecord &r)
+                                       {
+            if (r.traceSeq != seq_)
+                return;
+            if (!first)
+                out += ',';
+            first = false;
+            out += "{\"stage\":\"";
+            out += stageName(r.stage);
+            out += "\",\"start_us\":" + std::to_string((r.startNs - startNs_) / 1000);
+            out += ",\"dur_us\":" + std::to_string(r.durNs / 1000) + "}"; });
+        out += "]}";
+        return out;
+    }
+
+    bool RequestTrace::shouldLog(const TraceConfig &config) const noexcept
+    {
+        if (status_ >= 500)
+            return true;
+        if (elapsedNs() >= static_cast<std::uint64_t>(
+                               std::chrono::duration_cast<std::chrono::nanoseconds>(config.slowThreshold).count()))
+            return true;
+        return config.sampleEvery > 0 && seq_ % config.sampleEvery == 0;
+    }
+
+    std::string generateRequestId()
+    {
+        thread_local std::mt19937_64 rng{
+            std::random_device{}() ^
+            (static_cast<std::uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) << 1) ^
+            RequestTrace::nowNs()};
+
+        static constexpr char kHex[] = "0123456789abcdef";
+        std::uint64_t v = rng();
+        std::string id(16, '0');
+        for (int i = 15; i >= 0; --i)
+        {
+            id[static_cast<std::size_t>(i)] = kHex[v & 0x0f];
+            v >>= 4;
+        }
+        return id;
+    }
+
+    std::string sanitizeRequestId(std::string_view incoming)
+    {
+        if (incoming.empty() || incoming.size() > 64)
+            return {};
+        for (char c : incoming)
+        {
+            const bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                            (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.';
+            if (!ok)
+                return {};
+        }
+        return std::string(incoming);
+    }
+
+    void emitTraceLog(const RequestTrace &trace)
+    {
+        const TraceConfig cfg = traceConfig();
+        if (!cfg.enabled || !trace.shouldLog(cfg))
+            return;
+
+        std::string line = trace.toJson();
+        line += '\n';
+        std::fwrite(line.data(), 1, line.size(), stderr);
+    }
+} // namespace vix::registry::trace
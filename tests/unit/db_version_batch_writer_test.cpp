@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <vix/registry/db/Database.hpp>
+#include <vix/registry/db/VersionBatchWriter.hpp>
+
+using namespace vix::registry;
+
+namespace
+{
+    // Owns a throwaway user + package; deleting the user cascades to the
+    // package and its versions.
+    struct VersionBatchWriterDb : ::testing::Test
+    {
+        void SetUp() override
+        {
+            const char *host = std::getenv("REGISTRY_DB_HOST");
+            if (!host || *host == '\0')
+                GTEST_SKIP() << "REGISTRY_DB_HOST not set";
+
+            database = db::Database::fromEnvShared("REGISTRY_DB_");
+            ASSERT_NE(database, nullptr);
+
+            tag = "bw" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+            auto tx = database->makeTransaction();
+            auto &conn = tx.conn();
+
+            auto user = conn.prepare("INSERT INTO users (username, email, password_hash) VALUES (?,?,?)");
+            user->bind(1, tag);
+            user->bind(2, tag + "@example.invalid");
+            user->bind(3, std::string("x"));
+            user->exec();
+            const auto userId = static_cast<std::int64_t>(conn.lastInsertId());
+
+            auto pkg = conn.prepare("INSERT INTO packages (owner_user_id, name) VALUES (?,?)");
+            pkg->bind(1, userId);
+            pkg->bind(2, tag);
+            pkg->exec();
+            packageId = static_cast<std::uint64_t>(conn.lastInsertId());
+            tx.commit();
+        }
+
+        void TearDown() override
+        {
+            if (!database || tag.empty())
+                return;
+            auto tx = database->makeTransaction();
+            auto st = tx.conn().prepare("DELETE FROM users WHERE username = ?");
+            st->bind(1, tag);
+            st->exec();
+            tx.commit();
+        }
+
+        domain::Version version(const std::string &semver) const
+        {
+            domain::Version::Builder b;
+            b.packageId(packageId)
+                .semver(semver)
+                .artifactPath(tag + "/" + semver + "/" + tag + "-" + semver + ".tar.gz")
+                .sha256(std::string(64, 'c'))
+                .sizeBytes(3);
+            return b.build();
+        }
+
+        std::shared_ptr<db::Database> database;
+        std::string tag;
+        std::uint64_t packageId{0};
+    };
+} // namespace
+
+TEST_F(VersionBatchWriterDb, GroupsInsertsAndReportsConflicts)
+{
+    db::VersionBatchWriter writer(database);
+
+    const auto first = writer.writeBatch({version("1.0.0"), version("1.0.0"), version("1.1.0")});
+    ASSERT_EQ(first.size(), 3u);
+    EXPECT_EQ(first[0].status, db::PublishStatus::Committed);
+    EXPECT_EQ(first[1].status, db::PublishStatus::Conflict);
+    EXPECT_EQ(first[2].status, db::PublishStatus::Committed);
+    EXPECT_NE(first[0].versionId, 0u);
+    EXPECT_NE(first[2].versionId, 0u);
+    EXPECT_NE(first[0].versionId, first[2].versionId);
+
+    const auto second = writer.writeBatch({version("1.0.0"), version("2.0.0")});
+    ASSERT_EQ(second.size(), 2u);
+    EXPECT_EQ(second[0].status, db::PublishStatus::Conflict);
+    EXPECT_EQ(second[1].status, db::PublishStatus::Committed);
+}
+
+TEST_F(VersionBatchWriterDb, IsolatesARowTheServerRejects)
+{
+    db::VersionBatchWriter writer(database);
+
+    // No such package: the foreign key rejects this row only.
+    domain::Version::Builder b;
+    b.packageId(packageId + 1000000000)
+        .semver("3.0.0")
+        .artifactPath(tag + "/3.0.0/" + tag + "-3.0.0.tar.gz")
+        .sha256(std::string(64, 'c'))
+        .sizeBytes(3);
+
+    const auto results = writer.writeBatch({version("1.0.0"), b.build(), version("2.0.0")});
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].status, db::PublishStatus::Committed);
+    EXPECT_EQ(results[1].status, db::PublishStatus::Failed);
+    EXPECT_EQ(results[2].status, db::PublishStatus::Committed);
+}
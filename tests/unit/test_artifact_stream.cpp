@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <vix/registry/domain/errors.hpp>
+#include <vix/registry/http/ArtifactStream.hpp>
+#include <vix/registry/storage/LocalFileStorage.hpp>
+
+using namespace vix::registry;
+namespace fs = std::filesystem;
+
+namespace
+{
+    struct ArtifactStreamTest : ::testing::Test
+    {
+        void SetUp() override
+        {
+            root = fs::temp_directory_path() / "vix-artifact-stream";
+            fs::remove_all(root);
+            store = std::make_unique<storage::LocalFileStorage>(root);
+        }
+
+        void TearDown() override { fs::remove_all(root); }
+
+        fs::path root;
+        std::unique_ptr<storage::LocalFileStorage> store;
+    };
+} // namespace
+
+TEST_F(ArtifactStreamTest, WritesBoundedChunksInOrder)
+{
+    std::string blob(10 * 1000 + 7, '\0');
+    for (std::size_t i = 0; i < blob.size(); ++i)
+        blob[i] = static_cast<char>(i % 253);
+    store->put("big/1.0.0/big.tgz", blob);
+
+    std::string received;
+    std::size_t largest = 0;
+    std::size_t writes = 0;
+    http::streamArtifact(*store, "big/1.0.0/big.tgz", blob.size(), [&](std::string_view chunk)
+                         {
+        largest = std::max(largest, chunk.size());
+        ++writes;
+        received.append(chunk); },
+                         1000);
+
+    EXPECT_EQ(received, blob);
+    EXPECT_EQ(largest, 1000u);
+    EXPECT_EQ(writes, 11u);
+}
+
+TEST_F(ArtifactStreamTest, FailsOnTruncatedAndMissingBlobs)
+{
+    store->put("short/1.0.0/short.tgz", "abc");
+    auto sink = [](std::string_view) {};
+
+    EXPECT_THROW(http::streamArtifact(*store, "short/1.0.0/short.tgz", 10, sink, 2), domain::StorageError);
+    EXPECT_THROW(http::streamArtifact(*store, "gone/1.0.0/gone.tgz", 10, sink), domain::NotFoundError);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <vix/registry/SignalWatcher.hpp>
+#include <vix/registry/http/ArtifactStream.hpp>
+#include <vix/registry/http/Lifecycle.hpp>
+#include <vix/registry/storage/LocalFileStorage.hpp>
+
+using namespace std::chrono_literals;
+using vix::registry::SignalWatcher;
+using vix::registry::http::InflightTracker;
+
+TEST(InflightTracker, DrainRejectsNewWorkAndWaitsForInflight)
+{
+    InflightTracker tracker;
+
+    auto first = tracker.tryEnter();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(tracker.inflight(), 1u);
+
+    tracker.beginDrain();
+    EXPECT_TRUE(tracker.draining());
+    EXPECT_FALSE(tracker.tryEnter().has_value());
+    EXPECT_EQ(tracker.inflight(), 1u);
+
+    EXPECT_FALSE(tracker.waitIdle(std::chrono::steady_clock::now() + 20ms));
+
+    std::thread finisher([&]
+                         {
+        std::this_thread::sleep_for(20ms);
+        first.reset(); });
+    EXPECT_TRUE(tracker.waitIdle(std::chrono::steady_clock::now() + 5s));
+    finisher.join();
+    EXPECT_EQ(tracker.inflight(), 0u);
+}
+
+// Mirrors App::shutdown(): drain, wait for in-flight work, then close the
+// listener. A slow download must finish before the close.
+TEST(InflightTracker, SlowDownloadCompletesBeforeShutdownCloses)
+{
+    const auto root = std::filesystem::temp_directory_path() / "vix-drain-stream";
+    std::filesystem::remove_all(root);
+    vix::registry::storage::LocalFileStorage store(root);
+    const std::string blob(64 * 1024, 'x');
+    store.put("slow/1.0.0/slow.tgz", blob);
+
+    InflightTracker tracker;
+    std::atomic<bool> streaming{false};
+    std::atomic<bool> closed{false};
+    std::atomic<int> writesAfterClose{0};
+    std::string received;
+
+    std::thread download([&]
+                         {
+        auto guard = tracker.tryEnter();
+        ASSERT_TRUE(guard.has_value());
+        vix::registry::http::streamArtifact(store, "slow/1.0.0/slow.tgz", blob.size(), [&](std::string_view chunk)
+                                            {
+            streaming = true;
+            std::this_thread::sleep_for(5ms);
+            if (closed.load())
+                ++writesAfterClose;
+            received.append(chunk); },
+                                            4096); });
+
+    while (!streaming.load())
+        std::this_thread::sleep_for(1ms);
+
+    tracker.beginDrain();
+    EXPECT_TRUE(tracker.waitIdle(std::chrono::steady_clock::now() + 5s));
+    closed = true;
+
+    download.join();
+    EXPECT_EQ(writesAfterClose.load(), 0);
+    EXPECT_EQ(received.size(), blob.size());
+    std::filesystem::remove_all(root);
+}
+
+TEST(SignalWatcher, DispatchesOnWatcherThread)
+{
+    SignalWatcher::blockSignals();
+
+    std::atomic<int> hups{0};
+    {
+        SignalWatcher watcher;
+        watcher.on(SIGHUP, [&](int)
+                   { ++hups; });
+        watcher.start();
+
+        ::kill(::getpid(), SIGHUP);
+        for (int i = 0; i < 200 && hups.load() == 0; ++i)
+            std::this_thread::sleep_for(5ms);
+    }
+    EXPECT_EQ(hups.load(), 1);
+
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGTERM);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGHUP);
+    pthread_sigmask(SIG_UNBLOCK, &set, nullptr);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <vix/registry/db/PublishQueue.hpp>
+
+using namespace vix::registry;
+
+namespace
+{
+    // Records batch sizes and reports already-seen (package, semver) pairs
+    // as conflicts, like the unique key on `versions`.
+    class FakeBatchWriter : public db::IVersionBatchWriter
+    {
+    public:
+        std::vector<db::PublishResult> writeBatch(const std::vector<domain::Version> &batch) override
+        {
+            if (gate)
+                gate->wait(false);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            batchSizes.push_back(batch.size());
+
+            std::vector<db::PublishResult> out;
+            for (const auto &v : batch)
+            {
+                if (!seen.emplace(v.packageId(), v.semver()).second)
+                    out.push_back({db::PublishStatus::Conflict, 0, "dup"});
+                else
+                    out.push_back({db::PublishStatus::Committed, ++nextId, ""});
+            }
+            return out;
+        }
+
+        std::atomic<bool> *gate{nullptr};
+        std::mutex mutex;
+        std::vector<std::size_t> batchSizes;
+        std::set<std::pair<std::uint64_t, std::string>> seen;
+        std::uint64_t nextId{0};
+    };
+
+    domain::Version version(std::uint64_t pkg, const std::string &semver)
+    {
+        return domain::Version::Builder{}.packageId(pkg).semver(semver).build();
+    }
+} // namespace
+
+TEST(PublishQueue, CoalescesConcurrentPublishesIntoBatches)
+{
+    auto writer = std::make_shared<FakeBatchWriter>();
+    std::atomic<bool> open{false};
+    writer->gate = &open;
+
+    db::PublishQueue queue(writer, db::PublishQueueConfig{.maxBatch = 64, .maxPending = 1024, .maxDelay = std::chrono::microseconds(0)});
+
+    std::vector<std::future<db::PublishResult>> futures;
+    for (int i = 0; i < 100; ++i)
+        futures.push_back(queue.enqueue(version(1, "1.0." + std::to_string(i))));
+
+    open = true;
+    open.notify_all();
+
+    for (auto &f : futures)
+        EXPECT_EQ(f.get().status, db::PublishStatus::Committed);
+
+    // The first record may go alone while the writer is gated; the rest
+    // must be coalesced into at most maxBatch-sized groups.
+    EXPECT_LE(writer->batchSizes.size(), 3u);
+    EXPECT_EQ(queue.batchesCommitted(), writer->batchSizes.size());
+}
+
+TEST(PublishQueue, EachCallerGetsItsOwnOutcome)
+{
+    auto writer = std::make_shared<FakeBatchWriter>();
+    db::PublishQueue queue(writer);
+
+    auto a = queue.enqueue(version(7, "2.0.0"));
+    auto b = queue.enqueue(version(7, "2.0.0"));
+    auto c = queue.enqueue(version(8, "2.0.0"));
+
+    const auto ra = a.get();
+    EXPECT_EQ(ra.status, db::PublishStatus::Committed);
+    EXPECT_NE(ra.versionId, 0u);
+    EXPECT_EQ(b.get().status, db::PublishStatus::Conflict);
+    EXPECT_EQ(c.get().status, db::PublishStatus::Committed);
+}
+
+TEST(PublishQueue, StopDrainsPendingAndRejectsNewWork)
+{
+    auto writer = std::make_shared<FakeBatchWriter>();
+    db::PublishQueue queue(writer);
+
+    std::vector<std::future<db::PublishResult>> futures;
+    for (int i = 0; i < 20; ++i)
+        futures.push_back(queue.enqueue(version(3, "0.0." + std::to_string(i))));
+
+    queue.stop();
+    for (auto &f : futures)
+        EXPECT_EQ(f.get().status, db::PublishStatus::Committed);
+
+    EXPECT_EQ(queue.enqueue(version(3, "9.9.9")).get().status, db::PublishStatus::Failed);
+}
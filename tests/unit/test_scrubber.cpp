@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <vix/registry/services/ArtifactScrubber.hpp>
+#include <vix/registry/storage/LocalFileStorage.hpp>
+#include <vix/registry/storage/Sha256.hpp>
+
+using namespace std::chrono_literals;
+using namespace vix::registry;
+namespace fs = std::filesystem;
+
+namespace
+{
+    class FakeIndex : public db::IArtifactIndex
+    {
+    public:
+        std::unordered_map<std::string, db::ArtifactRecord>
+        lookup(const std::vector<std::string> &artifactPaths) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::unordered_map<std::string, db::ArtifactRecord> found;
+            for (const auto &p : artifactPaths)
+            {
+                if (auto it = rows.find(p); it != rows.end())
+                    found.emplace(p, it->second);
+            }
+            return found;
+        }
+
+        void add(const std::string &key, const std::string &content)
+        {
+            rows[key] = db::ArtifactRecord{storage::Sha256::hex(content), content.size()};
+        }
+
+        std::map<std::string, db::ArtifactRecord> rows;
+
+    private:
+        std::mutex mutex_;
+    };
+
+    // A backend whose listings carry no modification time.
+    class NoTimestampStorage : public storage::LocalFileStorage
+    {
+    public:
+        using LocalFileStorage::LocalFileStorage;
+
+        storage::ObjectPage list(const std::string &prefix,
+                                 const std::string &startAfter,
+                                 std::size_t limit) override
+        {
+            auto page = LocalFileStorage::list(prefix, startAfter, limit);
+            for (auto &o : page.objects)
+                o.lastModified.reset();
+            return page;
+        }
+    };
+
+    struct ScrubberTest : ::testing::Test
+    {
+        void SetUp() override
+        {
+            const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+            root = fs::temp_directory_path() / (std::string("vix-scrub-") + info->name());
+            fs::remove_all(root);
+            store = std::make_shared<storage::LocalFileStorage>(root);
+            index = std::make_shared<FakeIndex>();
+        }
+
+        void TearDown() override { fs::remove_all(root); }
+
+        static void age(const fs::path &p, std::chrono::hours by)
+        {
+            fs::last_write_time(p, fs::last_write_time(p) - by);
+        }
+
+        fs::path root;
+        std::shared_ptr<storage::LocalFileStorage> store;
+        std::shared_ptr<FakeIndex> index;
+    };
+
+    services::ScrubConfig fastConfig()
+    {
+        services::ScrubConfig cfg;
+        cfg.pageSize = 2;
+        cfg.hashWorkers = 4;
+        cfg.maxBytesPerSecond = 0;
+        cfg.orphanGrace = 3600s;
+        cfg.uploadGrace = 3600s;
+        cfg.deleteOrphans = true;
+        return cfg;
+    }
+} // namespace
+
+TEST_F(ScrubberTest, VerifiesQuarantinesAndCollectsOrphans)
+{
+    store->put("a/1.0.0/a.tar.gz", "alpha");
+    store->put("b/1.0.0/b.tar.gz", "bravo");
+    store->put("c/1.0.0/c.tar.gz", "charlie");
+    store->put("d/1.0.0/d.tar.gz", "delta");
+    store->put("e/1.0.0/e.tar.gz", "echo-truncated");
+
+    index->add("a/1.0.0/a.tar.gz", "alpha");
+    index->add("b/1.0.0/b.tar.gz", "BRAVO"); // same size, different bytes
+    index->add("e/1.0.0/e.tar.gz", "echo");  // size mismatch
+
+    age(store->pathFor("c/1.0.0/c.tar.gz"), 48h); // old orphan
+    // d is an orphan inside the grace period
+
+    std::ofstream(root / ".tmp" / "upload-stale") << "partial";
+    age(root / ".tmp" / "upload-stale", 48h);
+    std::ofstream(root / ".tmp" / "upload-live") << "partial";
+
+    services::ArtifactScrubber scrubber(store, index, fastConfig());
+    ASSERT_TRUE(scrubber.runPass());
+
+    const auto s = scrubber.stats();
+    EXPECT_EQ(s.passesCompleted, 1u);
+    EXPECT_EQ(s.objectsScanned, 5u);
+    EXPECT_EQ(s.verified, 1u);
+    EXPECT_EQ(s.corrupt, 2u);
+    EXPECT_EQ(s.quarantined, 2u);
+    EXPECT_EQ(s.orphansFound, 1u);
+    EXPECT_EQ(s.orphansDeleted, 1u);
+    EXPECT_EQ(s.orphanBytesFreed, 7u);
+    EXPECT_EQ(s.staleUploadsPurged, 1u);
+    EXPECT_EQ(s.errors, 0u);
+    EXPECT_TRUE(s.cursor.empty());
+    EXPECT_FALSE(s.running);
+
+    EXPECT_TRUE(store->exists("a/1.0.0/a.tar.gz"));
+    EXPECT_FALSE(store->exists("b/1.0.0/b.tar.gz"));
+    EXPECT_TRUE(fs::exists(root / ".quarantine" / "b/1.0.0/b.tar.gz"));
+    EXPECT_TRUE(fs::exists(root / ".quarantine" / "e/1.0.0/e.tar.gz"));
+    EXPECT_FALSE(store->exists("c/1.0.0/c.tar.gz"));
+    EXPECT_TRUE(store->exists("d/1.0.0/d.tar.gz"));
+    EXPECT_FALSE(fs::exists(root / ".tmp" / "upload-stale"));
+    EXPECT_TRUE(fs::exists(root / ".tmp" / "upload-live"));
+
+    // Quarantined blobs are out of the walk.
+    ASSERT_TRUE(scrubber.runPass());
+    EXPECT_EQ(scrubber.stats().objectsScanned, 7u);
+}
+
+TEST_F(ScrubberTest, KeepsOrphansWhenDeletionDisabled)
+{
+    store->put("x/1.0.0/x.tar.gz", "unreferenced");
+    age(store->pathFor("x/1.0.0/x.tar.gz"), 48h);
+
+    auto cfg = fastConfig();
+    cfg.deleteOrphans = false;
+    services::ArtifactScrubber scrubber(store, index, cfg);
+    ASSERT_TRUE(scrubber.runPass());
+
+    EXPECT_EQ(scrubber.stats().orphansFound, 1u);
+    EXPECT_EQ(scrubber.stats().orphansDeleted, 0u);
+    EXPECT_TRUE(store->exists("x/1.0.0/x.tar.gz"));
+}
+
+TEST_F(ScrubberTest, OnlyReportsOrphansByDefault)
+{
+    store->put("x/1.0.0/x.tar.gz", "unreferenced");
+    age(store->pathFor("x/1.0.0/x.tar.gz"), 48h);
+
+    services::ArtifactScrubber scrubber(store, index);
+    ASSERT_TRUE(scrubber.runPass());
+
+    EXPECT_EQ(scrubber.stats().orphansFound, 1u);
+    EXPECT_EQ(scrubber.stats().orphansDeleted, 0u);
+    EXPECT_TRUE(store->exists("x/1.0.0/x.tar.gz"));
+}
+
+TEST_F(ScrubberTest, SkipsDeletionWhenAPageIsMostlyOrphans)
+{
+    for (const char *name : {"a", "b", "c", "d"})
+    {
+        const std::string key = std::string(name) + "/1.0.0/" + name + ".tar.gz";
+        store->put(key, name);
+        age(store->pathFor(key), 48h);
+    }
+    index->add("a/1.0.0/a.tar.gz", "a");
+
+    auto cfg = fastConfig();
+    cfg.pageSize = 4;
+    services::ArtifactScrubber scrubber(store, index, cfg);
+    ASSERT_TRUE(scrubber.runPass());
+
+    auto s = scrubber.stats();
+    EXPECT_EQ(s.orphansFound, 3u);
+    EXPECT_EQ(s.orphansDeleted, 0u);
+    EXPECT_EQ(s.orphanDeletesSkipped, 3u);
+    EXPECT_EQ(s.errors, 1u);
+    EXPECT_TRUE(store->exists("d/1.0.0/d.tar.gz"));
+
+    cfg.maxOrphanPercent = 100;
+    scrubber.reconfigure(cfg);
+    ASSERT_TRUE(scrubber.runPass());
+
+    s = scrubber.stats();
+    EXPECT_EQ(s.orphansDeleted, 3u);
+    EXPECT_TRUE(store->exists("a/1.0.0/a.tar.gz"));
+    EXPECT_FALSE(store->exists("d/1.0.0/d.tar.gz"));
+}
+
+TEST_F(ScrubberTest, KeepsOrphansOfUnknownAge)
+{
+    auto untimed = std::make_shared<NoTimestampStorage>(root);
+    untimed->put("x/1.0.0/x.tar.gz", "unreferenced");
+    age(untimed->pathFor("x/1.0.0/x.tar.gz"), 48h);
+
+    services::ArtifactScrubber scrubber(untimed, index, fastConfig());
+    ASSERT_TRUE(scrubber.runPass());
+
+    EXPECT_EQ(scrubber.stats().objectsScanned, 1u);
+    EXPECT_EQ(scrubber.stats().orphansFound, 0u);
+    EXPECT_EQ(scrubber.stats().orphansDeleted, 0u);
+    EXPECT_TRUE(untimed->exists("x/1.0.0/x.tar.gz"));
+}
+
+TEST_F(ScrubberTest, ResumesFromCheckpoint)
+{
+    for (const char *name : {"p1", "p2", "p3", "p4", "p5"})
+    {
+        const std::string key = std::string(name) + "/1.0.0/pkg.tar.gz";
+        store->put(key, name);
+        index->add(key, name);
+    }
+
+    auto cfg = fastConfig();
+    cfg.checkpointPath = root / ".scrub-cursor";
+    std::ofstream(cfg.checkpointPath) << "p2/1.0.0/pkg.tar.gz\n";
+
+    services::ArtifactScrubber scrubber(store, index, cfg);
+    ASSERT_TRUE(scrubber.runPass());
+    EXPECT_EQ(scrubber.stats().verified, 3u);
+    EXPECT_FALSE(fs::exists(cfg.checkpointPath));
+
+    ASSERT_TRUE(scrubber.runPass());
+    EXPECT_EQ(scrubber.stats().verified, 8u);
+}
+
+TEST(ByteRateLimiter, PacesAndCancels)
+{
+    std::atomic<bool> cancelled{false};
+
+    services::ByteRateLimiter limiter(1000);
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(limiter.acquire(1000, cancelled)); // burst allowance
+    EXPECT_TRUE(limiter.acquire(100, cancelled));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 80ms);
+
+    cancelled = true;
+    EXPECT_FALSE(limiter.acquire(10000, cancelled));
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vix/registry/domain/errors.hpp>
+#include <vix/registry/services/DownloadService.hpp>
+#include <vix/registry/services/VersionService.hpp>
+
+using namespace vix::registry;
+
+namespace
+{
+    domain::Version::Builder validVersion()
+    {
+        domain::Version::Builder b;
+        b.packageId(1)
+            .semver("1.2.3")
+            .artifactPath("pkg/1.2.3/pkg-1.2.3.tar.gz")
+            .sha256(std::string(64, 'a'))
+            .sizeBytes(42);
+        return b;
+    }
+
+    class FakeVersionLookup : public db::IVersionLookup
+    {
+    public:
+        std::vector<db::VersionArtifact>
+        findArtifacts(const std::string &packageName, const std::string &semver) override
+        {
+            std::vector<db::VersionArtifact> found;
+            for (const auto &[name, version, row] : rows)
+            {
+                if (name == packageName && version == semver)
+                    found.push_back(row);
+            }
+            return found;
+        }
+
+        void add(const std::string &name, const std::string &version, const std::string &path, bool yanked = false)
+        {
+            rows.push_back({name, version, db::VersionArtifact{path, std::string(64, 'b'), 7, yanked}});
+        }
+
+        struct Row
+        {
+            std::string name;
+            std::string version;
+            db::VersionArtifact artifact;
+        };
+        std::vector<Row> rows;
+    };
+} // namespace
+
+TEST(VersionService, AcceptsWellFormedVersion)
+{
+    EXPECT_NO_THROW(services::VersionService::validate(validVersion().build()));
+}
+
+TEST(VersionService, RejectsMalformedVersions)
+{
+    using domain::ValidationError;
+
+    EXPECT_THROW(services::VersionService::validate(validVersion().packageId(0).build()), ValidationError);
+    EXPECT_THROW(services::VersionService::validate(validVersion().semver("").build()), ValidationError);
+    EXPECT_THROW(services::VersionService::validate(validVersion().semver("banana").build()), ValidationError);
+    EXPECT_THROW(services::VersionService::validate(validVersion().artifactPath("../x").build()), ValidationError);
+    EXPECT_THROW(services::VersionService::validate(validVersion().sha256("abc").build()), ValidationError);
+    EXPECT_THROW(services::VersionService::validate(validVersion().sha256(std::string(64, 'z')).build()), ValidationError);
+}
+
+TEST(Semver, AcceptsSemver2)
+{
+    for (const char *v : {"0.0.0", "1.2.3", "10.20.30", "1.0.0-alpha", "1.0.0-alpha.1", "1.0.0-0.3.7",
+                          "1.0.0-x-y.z", "1.0.0+20130313144700", "1.0.0-beta+exp.sha.5114f85",
+                          "1.0.0+001", "1.0.0-alpha.1+build.5"})
+        EXPECT_TRUE(domain::isValidSemver(v)) << v;
+}
+
+TEST(Semver, RejectsMalformedVersions)
+{
+    for (const char *v : {"", "banana", "1", "1.2", "1.2.3.4", "v1.2.3", "01.2.3", "1.02.3", "1.2.03",
+                          "1.2.3-", "1.2.3+", "1.2.3-01", "1.2.3-alpha..1", "1.2.3-al_pha",
+                          "1.2.3+build+2", "-1.2.3", "1.2.-3", "1..3"})
+        EXPECT_FALSE(domain::isValidSemver(v)) << v;
+}
+
+TEST(DownloadService, ResolvesKeyFromVersionRow)
+{
+    auto lookup = std::make_shared<FakeVersionLookup>();
+    lookup->add("json", "1.0.0", "owner-7/json/1.0.0/json-1.0.0.tar.gz");
+    services::DownloadService downloads(lookup);
+
+    const auto a = downloads.resolve("json", "1.0.0", "json-1.0.0.tar.gz");
+    EXPECT_EQ(a.key, "owner-7/json/1.0.0/json-1.0.0.tar.gz");
+    EXPECT_EQ(a.sha256, std::string(64, 'b'));
+    EXPECT_EQ(a.sizeBytes, 7u);
+}
+
+TEST(DownloadService, MapsMissingYankedAndAmbiguousVersions)
+{
+    auto lookup = std::make_shared<FakeVersionLookup>();
+    lookup->add("json", "1.0.0", "json/1.0.0/json-1.0.0.tar.gz");
+    lookup->add("json", "0.9.0", "json/0.9.0/json-0.9.0.tar.gz", true);
+    lookup->add("log", "2.0.0", "alice/log/2.0.0/log-2.0.0.tar.gz");
+    lookup->add("log", "2.0.0", "bob/log/2.0.0/log-2.0.0.tar.gz");
+    services::DownloadService downloads(lookup);
+
+    EXPECT_THROW(downloads.resolve("json", "2.0.0", "json-2.0.0.tar.gz"), domain::NotFoundError);
+    EXPECT_THROW(downloads.resolve("json", "1.0.0", "other.tar.gz"), domain::NotFoundError);
+    EXPECT_THROW(downloads.resolve("json", "0.9.0", "json-0.9.0.tar.gz"), domain::GoneError);
+    EXPECT_THROW(downloads.resolve("log", "2.0.0", "log-2.0.0.tar.gz"), domain::ConflictError);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include <vix/registry/http/Middleware.hpp>
+#include <vix/registry/trace/Tracing.hpp>
+
+using namespace vix::registry::trace;
+
+namespace
+{
+    struct FakeRequest
+    {
+        std::string method() const { return "GET"; }
+        std::string path() const { return "/v1/artifacts/x/1.0.0/x.tar.gz"; }
+        std::string header(const std::string &name) const
+        {
+            const auto it = headers.find(name);
+            return it == headers.end() ? std::string() : it->second;
+        }
+
+        std::map<std::string, std::string> headers;
+    };
+
+    struct FakeResponse
+    {
+        FakeResponse &status(int code)
+        {
+            statusCode = code;
+            return *this;
+        }
+        void header(const std::string &name, const std::string &value) { headers[name] = value; }
+        void json(const std::string &payload) { body = payload; }
+
+        int statusCode{200};
+        std::string body;
+        std::map<std::string, std::string> headers;
+    };
+
+    // Logs every request while alive.
+    struct LogEverything
+    {
+        LogEverything() : saved(traceConfig())
+        {
+            TraceConfig cfg = saved;
+            cfg.enabled = true;
+            cfg.serverTiming = true;
+            cfg.sampleEvery = 1;
+            setTraceConfig(cfg);
+        }
+        ~LogEverything() { setTraceConfig(saved); }
+
+        TraceConfig saved;
+    };
+} // namespace
+
+TEST(Tracing, SpansAccumulatePerStageOnCurrentTrace)
+{
+    EXPECT_EQ(RequestTrace::current(), nullptr);
+    {
+        // No trace: spans are a no-op.
+        ScopedSpan span(Stage::DbQuery);
+    }
+
+    RequestTrace trace("GET", "/v1/packages/x");
+    EXPECT_EQ(RequestTrace::current(), &trace);
+    EXPECT_EQ(trace.requestId().size(), 16u);
+
+    trace.record(Stage::DbQuery, RequestTrace::nowNs(), 1'500'000);
+    trace.record(Stage::DbQuery, RequestTrace::nowNs(), 500'000);
+    {
+        ScopedSpan span(Stage::Storage);
+    }
+
+    EXPECT_EQ(trace.stageNs(Stage::DbQuery), 2'000'000u);
+    EXPECT_EQ(trace.stageNs(Stage::Auth), 0u);
+
+    const std::string timing = trace.serverTiming();
+    EXPECT_NE(timing.find("db;dur=2.000"), std::string::npos);
+    EXPECT_NE(timing.find("storage;dur="), std::string::npos);
+    EXPECT_EQ(timing.find("auth;"), std::string::npos);
+    EXPECT_NE(timing.find("total;dur="), std::string::npos);
+
+    const std::string json = trace.toJson();
+    EXPECT_NE(json.find("\"request_id\":\"" + trace.requestId() + "\""), std::string::npos);
+    EXPECT_NE(json.find("\"path\":\"/v1/packages/x\""), std::string::npos);
+    EXPECT_NE(json.find("{\"stage\":\"db\""), std::string::npos);
+    EXPECT_NE(json.find("{\"stage\":\"storage\""), std::string::npos);
+}
+
+TEST(Tracing, NestedTraceRestoresPrevious)
+{
+    RequestTrace outer("GET", "/a", "outer-id");
+    {
+        RequestTrace inner("GET", "/b");
+        EXPECT_EQ(RequestTrace::current(), &inner);
+    }
+    EXPECT_EQ(RequestTrace::current(), &outer);
+    EXPECT_EQ(outer.requestId(), "outer-id");
+}
+
+TEST(Tracing, RingKeepsOnlyNewestSpans)
+{
+    RequestTrace trace("GET", "/many");
+    for (std::size_t i = 0; i < SpanRing::kCapacity + 10; ++i)
+        trace.record(Stage::Cache, RequestTrace::nowNs(), 1000);
+
+    std::size_t seen = 0;
+    SpanRing::local().forEachSince(0, [&](const SpanRecord &)
+                                   { ++seen; });
+    EXPECT_EQ(seen, SpanRing::kCapacity);
+}
+
+TEST(Tracing, SamplingAlwaysKeepsErrorsAndSlowRequests)
+{
+    TraceConfig cfg;
+    cfg.sampleEvery = 0;
+    cfg.slowThreshold = std::chrono::hours(1);
+
+    RequestTrace trace("GET", "/x");
+    EXPECT_FALSE(trace.shouldLog(cfg));
+
+    trace.setStatus(503);
+    EXPECT_TRUE(trace.shouldLog(cfg));
+
+    trace.setStatus(200);
+    cfg.slowThreshold = std::chrono::milliseconds(0);
+    EXPECT_TRUE(trace.shouldLog(cfg));
+}
+
+TEST(Tracing, RequestIdSanitization)
+{
+    EXPECT_EQ(sanitizeRequestId("abc-123_X.y"), "abc-123_X.y");
+    EXPECT_EQ(sanitizeRequestId(""), "");
+    EXPECT_EQ(sanitizeRequestId("bad id"), "");
+    EXPECT_EQ(sanitizeRequestId("x\r\nInjected: 1"), "");
+    EXPECT_EQ(sanitizeRequestId(std::string(65, 'a')), "");
+}
+
+TEST(Tracing, TracedLogsTheStatusTheHandlerSent)
+{
+    using vix::registry::http::traced;
+    using vix::registry::http::withStatus;
+    LogEverything logAll;
+
+    auto handler = traced([](FakeRequest &, FakeResponse &res)
+                          {
+        ScopedSpan span(Stage::DbQuery);
+        withStatus(res, 404).json("{}"); });
+
+    FakeRequest req;
+    req.headers["X-Request-Id"] = "req-42";
+    FakeResponse res;
+
+    ::testing::internal::CaptureStderr();
+    handler(req, res);
+    const std::string log = ::testing::internal::GetCapturedStderr();
+
+    EXPECT_EQ(res.statusCode, 404);
+    EXPECT_EQ(res.headers["X-Request-Id"], "req-42");
+    EXPECT_NE(res.headers["Server-Timing"].find("db;dur="), std::string::npos);
+    EXPECT_NE(log.find("\"status\":404"), std::string::npos) << log;
+    EXPECT_NE(log.find("req-42"), std::string::npos) << log;
+}
+
+TEST(Tracing, TracedLogsThrowingHandlersAs500)
+{
+    using vix::registry::http::traced;
+    LogEverything logAll;
+
+    auto handler = traced([](FakeRequest &, FakeResponse &)
+                          { throw std::runtime_error("boom"); });
+
+    FakeRequest req;
+    FakeResponse res;
+
+    ::testing::internal::CaptureStderr();
+    EXPECT_THROW(handler(req, res), std::runtime_error);
+    const std::string log = ::testing::internal::GetCapturedStderr();
+
+    EXPECT_NE(log.find("\"status\":500"), std::string::npos) << log;
+}